@@ -15,53 +15,96 @@
 #include <ctime>
 #include "RegManager.h"
 #include "AgriPoliS.h"
+#include "textinput.h"
+#include "RegThreadPool.h"
 //---------------------------------------------------------------------------
 
+// runs the replications REPLICATION_FIRST..REPLICATION_LAST, JOBS at a time.
+// The input files are read once, each replication works on a copy of g and
+// writes to its own output directory.
+static void runReplications(RegGlobalsInfo* g) {
+	g->readInputs();
+	// the replications solve many of the same MIPs
+	if (g->MIP_CACHE_MB > 0)
+		g->mipcache = make_shared<RegMipCache>((size_t)g->MIP_CACHE_MB*1024*1024);
+
+	int n = g->REPLICATION_LAST - g->REPLICATION_FIRST + 1;
+	vector<RegGlobalsInfo*> globals;
+	for (int i = 0; i < n; ++i) {
+		RegGlobalsInfo* rg = g->clone();
+		rg->V = g->REPLICATION_FIRST + i;
+		rg->SEED = rg->V*119;
+		rg->INIT_OUTPUT = true;
+		rg->OUTPUTFILE = g->OUTPUTFILE + "replication_" + to_string(rg->V) + "/";
+		globals.push_back(rg);
+	}
+
+	RegThreadPool jobs(min(g->JOBS, n));
+	jobs.run(n, [&](int i) {
+		RegManagerInfo *Manager = new RegManagerInfo(globals[i]);
+		Manager->simulate();
+		delete Manager;
+		cout << "Replication " << globals[i]->V << " finished\n";
+	});
+	if (g->mipcache)
+		g->mipcache->printStatistics(cout);
+	for (int i = 0; i < n; ++i)
+		delete globals[i];
+}
+
 int main (int argc, char * argv[]) {
 	auto start = std::chrono::system_clock::now();
 	std::time_t time0 = std::chrono::system_clock::to_time_t(start);
 	auto ctime_start =  std::ctime(&time0);
 	cout << ctime_start << "\n";
 
-	    gg= new RegGlobalsInfo();
-		gg->TimeStart = ctime_start;
+	    RegGlobalsInfo* g = new RegGlobalsInfo();
+		g->TimeStart = ctime_start;
 
-		gg->ARGC = argc;
-		gg->ARGV = &argv[0];
+		g->ARGC = argc;
+		g->ARGV = &argv[0];
 		
-		gg->readFromCommandLine();
-		vector<string> args = gg->commandlineFILES;
+		g->readFromCommandLine();
+		vector<string> args = g->commandlineFILES;
 		int nFiles = args.size();
         if (nFiles < 1) {
-  		   cout << gg->UsageString; 
+  		   cout << g->UsageString; 
            return 1;
         }
 	
-		optiondir = args[0];
-		if (nFiles > 1) gg->SCENARIOFILE = args[1];
-		else gg->SCENARIOFILE = "scenario.txt";
-		readScenario();
-		//gg->DebMip = deb_mip();
+		g->OPTIONFILEdir = args[0] + "/";
+		if (nFiles > 1) g->SCENARIOFILE = args[1];
+		else g->SCENARIOFILE = "scenario.txt";
+		readScenario(g);
+		//g->DebMip = deb_mip(g);
 		
-		if (nFiles > 2 ) gg->V = atoi(args[2].c_str());
-		if (gg->V !=0 ) { 
-			gg->INIT_OUTPUT = false;
+		if (nFiles > 2 ) g->V = atoi(args[2].c_str());
+		if (g->V !=0 ) { 
+			g->INIT_OUTPUT = false;
 		} else {
-			gg->INIT_OUTPUT = true;
+			g->INIT_OUTPUT = true;
 		}
-		gg->SEED = gg->V*119;
+		g->SEED = g->V*119;
 
-        options(optiondir);
-		if (gg->DebMip) 
-			deb_mip();
+        options(g);
+		if (g->DebMip) 
+			deb_mip(g);
         
-	   	RegManagerInfo *Manager = new RegManagerInfo(gg);
-        Manager->simulate();
+		if (g->REPLICATION_FIRST >= 0)
+			runReplications(g);
+		else {
+			if (g->MIP_CACHE_MB > 0)
+				g->mipcache = make_shared<RegMipCache>((size_t)g->MIP_CACHE_MB*1024*1024);
+			RegManagerInfo *Manager = new RegManagerInfo(g);
+			Manager->simulate();
+			if (g->mipcache)
+				g->mipcache->printStatistics(cout);
+		}
 		auto end = std::chrono::system_clock::now();
 		std::time_t end_time = std::chrono::system_clock::to_time_t(end);
-		gg->TimeStop = std::ctime(&end_time);
+		g->TimeStop = std::ctime(&end_time);
 
-		cout << gg->TimeStop << "\n";
+		cout << g->TimeStop << "\n";
         return 0;
 }
 
@@ -23,10 +23,7 @@
 
 const string OPTFILE = "options.txt";
 
-RegGlobalsInfo* gg;
 
-static map<string,string> optionsdata;
-static string optiondir;
 
 static void tokenize(const string& str,
                       vector<string>& tokens,
@@ -79,10 +76,10 @@ static SimPhase phaseFromStr(string name) {
    return result;
 }
 
-bool deb_mip() {
+bool deb_mip(RegGlobalsInfo* g) {
 	bool result = false;
 	string fname = "debug_mip.txt";
-	string fullfn = optiondir + "/"+ fname;
+	string fullfn = g->OPTIONFILEdir + fname;
 	
 	ifstream ins(fullfn.c_str());
 	if (ins.good()) {
@@ -109,23 +106,23 @@ bool deb_mip() {
 				(int(*)(int)) std::toupper);
 
 			if (prop.compare("FARM_ID") == 0)
-				gg->uFarmId = atoi(tokens[1].c_str());
+				g->uFarmId = atoi(tokens[1].c_str());
 			else if (prop.compare("FARM_NAME") == 0)
-				gg->uFarmName = tokens[1];
+				g->uFarmName = tokens[1];
 			else if (prop.compare("ITERATION") == 0)
-				gg->uIter = atoi(tokens[1].c_str());
+				g->uIter = atoi(tokens[1].c_str());
 			else if (prop.compare("PROCESS") == 0)
-				gg->uPhase = phaseFromStr(tokens[1]);
+				g->uPhase = phaseFromStr(tokens[1]);
 		}
 		ins.close();
 	}
 	return result;
 }
 
-void readScenario() {
+void readScenario(RegGlobalsInfo* g) {
 	ifstream ins;
 	stringstream gfile;
-	gfile << optiondir + "/" << gg->SCENARIOFILE;
+	gfile << g->OPTIONFILEdir << g->SCENARIOFILE;
 	ins.open(gfile.str().c_str(), ios::in);
 	if (!ins.is_open()) {
 		cerr << "Error while opening: " << gfile.str() << "\n";
@@ -150,13 +147,13 @@ void readScenario() {
 		switch (state) {
 		case 0:
 			if (s2.compare("SCENARIO") == 0) {
-				gg->Scenario = trim(tokens[1]);
+				g->Scenario = trim(tokens[1]);
 			}
 			else if (s2.compare("DESCRIPTION") == 0) {
-				gg->Scenario_Description = trim(tokens[1]);
+				g->Scenario_Description = trim(tokens[1]);
 			}
 			else if (s2.compare("POLICY_FILE") == 0) {
-				gg->POLICYFILE = trim(tokens[1]);
+				g->POLICYFILE = trim(tokens[1]);
 			}
 			else if (s2.compare("[GLOBALS]") == 0){
 				state = 1;
@@ -176,24 +173,24 @@ void readScenario() {
 				int sz = tokens1.size();
 				for (int i = 0; i < sz; ++i) {
 					if (tokens1[i].compare("=") != 0) {
-						gg->Livestock_Invs.insert(tokens1[i]);
+						g->Livestock_Invs.insert(tokens1[i]);
 					}
 				}
 				/*
-				if (gg->Livestock_Invs.size() == 0)
-					gg->Scenario_globs.insert(pair("RESTRICTINVESTMENTS", "false"));
+				if (g->Livestock_Invs.size() == 0)
+					g->Scenario_globs.insert(pair("RESTRICTINVESTMENTS", "false"));
 				else
-					gg->Scenario_globs.insert(pair("RESTRICTINVESTMENTS", "true"));
+					g->Scenario_globs.insert(pair("RESTRICTINVESTMENTS", "true"));
 					//*/
 			}else
-				gg->Scenario_globs.insert(pair<string, string>(s2, trim(tokens[1])));
+				g->Scenario_globs.insert(pair<string, string>(s2, trim(tokens[1])));
 			break;
 		case 2:
 			if (s2.compare("[GLOBALS]") == 0) {
 				state = 1;
 				break;
 			}
-			gg->Scenario_options.insert(pair<string, string>(s2, trim(tokens[1])));
+			g->Scenario_options.insert(pair<string, string>(s2, trim(tokens[1])));
 			break;
 		default:;
 		}
@@ -202,10 +199,10 @@ void readScenario() {
 	return;
 }
 
-void readoptions() {
+void readoptions(RegGlobalsInfo* g, map<string,string>& optionsdata) {
     ifstream ins;
     stringstream gfile;
-    gfile << optiondir <<OPTFILE;
+    gfile << g->OPTIONFILEdir <<OPTFILE;
     ins.open(gfile.str().c_str(),ios::in);
 	if ( ! ins.is_open() ) {
        cerr << "Error while opening: " << gfile.str() << "\n";
@@ -228,12 +225,12 @@ void readoptions() {
         std::transform(s2.begin(), s2.end(), s2.begin(),
                (int(*)(int)) std::toupper);
 
-		//if (gg->Scenario_options.count(s2))
-		//	optionsdata.insert(pair<string, string>(s2, gg->Scenario_options[tokens[0]]));
+		//if (g->Scenario_options.count(s2))
+		//	optionsdata.insert(pair<string, string>(s2, g->Scenario_options[tokens[0]]));
 		//else 
             optionsdata.insert(pair<string, string>(s2,tokens[1]));
     }
-	for (auto x : gg->Scenario_options) {
+	for (auto x : g->Scenario_options) {
 		//if (optionsdata.count(x.first)>0)
 		   optionsdata[x.first] = x.second;
 	}
@@ -250,40 +247,40 @@ DISTRIB_TYPE make_distribType(string str) {
 	return distype;
 }
 
-void setoptions(){
-gg->RUNS=atoi(optionsdata["RUNS"].c_str());
-gg->TEILER = atoi(optionsdata["TEILER"].c_str());
+void setoptions(RegGlobalsInfo* g, map<string,string>& optionsdata){
+g->RUNS=atoi(optionsdata["RUNS"].c_str());
+g->TEILER = atoi(optionsdata["TEILER"].c_str());
 
-gg->Rent_Variation = optionsdata["RENT_VARIATION"].compare("true") == 0 ? true : false;
+g->Rent_Variation = optionsdata["RENT_VARIATION"].compare("true") == 0 ? true : false;
 
 double bmin = atof(optionsdata["BETA_MIN"].c_str());
 double bmax = atof(optionsdata["BETA_MAX"].c_str());
 if (bmin > 0 && bmin < 1)
-	gg->Beta_min = bmin;
+	g->Beta_min = bmin;
 if (bmax > 0 && bmax < 1)
-	gg->Beta_max = bmax;
-if (gg->Beta_max < gg->Beta_min) {
+	g->Beta_max = bmax;
+if (g->Beta_max < g->Beta_min) {
 	cout << "Beta_min is larger than Beta_max ! Exiting ..." << endl;
 	exit(4);
 }
 
-gg->RestrictInvestments=optionsdata["RESTRICTINVESTMENTS"].compare("true") == 0 ? true : false;
+g->RestrictInvestments=optionsdata["RESTRICTINVESTMENTS"].compare("true") == 0 ? true : false;
 
-gg->NASG = optionsdata["NASG"].compare("true") == 0 ? true : false;
+g->NASG = optionsdata["NASG"].compare("true") == 0 ? true : false;
 
-gg->ManagerDemographics = optionsdata["MANAGERDEMOGRAPHICS"].compare("true") == 0 ? true : false;
-gg->YoungFarmer = optionsdata["YOUNGFARMER"].compare("true") == 0 ? true : false;
-if (gg->YoungFarmer) {
+g->ManagerDemographics = optionsdata["MANAGERDEMOGRAPHICS"].compare("true") == 0 ? true : false;
+g->YoungFarmer = optionsdata["YOUNGFARMER"].compare("true") == 0 ? true : false;
+if (g->YoungFarmer) {
 	string stop_iteration = optionsdata["STOP_ITERATION_YOUNGFARMERPAY"];
 	if (stop_iteration.compare("")!=0)
-	    gg->Stop_Iteration_YoungFarmerPay = atoi(stop_iteration.c_str());
+	    g->Stop_Iteration_YoungFarmerPay = atoi(stop_iteration.c_str());
 	else 
-		gg->Stop_Iteration_YoungFarmerPay = gg->RUNS;
+		g->Stop_Iteration_YoungFarmerPay = g->RUNS;
 }
 
-gg->DebMip = optionsdata["DEBUG_MIP"].compare("true") == 0 ? true : false;
+g->DebMip = optionsdata["DEBUG_MIP"].compare("true") == 0 ? true : false;
 
-gg->ManagerDistribType = make_distribType(optionsdata["MANAGERCOEFFDISTRIBUTION"]);
+g->ManagerDistribType = make_distribType(optionsdata["MANAGERCOEFFDISTRIBUTION"]);
 
 string tstr = optionsdata["INPUTFILEDIR"];
 
@@ -291,29 +288,29 @@ namespace fs=std::filesystem;
 fs::path inpath, opath;
 
 if ((tstr.compare("=")==0)|| tstr.compare("")==0) { 
-   inpath.assign(optiondir);
+   inpath.assign(g->OPTIONFILEdir);
 }
 else 
    inpath.assign(tstr);
 
 inpath/="";
-gg->INPUTFILEdir= inpath.string();
+g->INPUTFILEdir= inpath.string();
 
 //TEST
-//cout << "INP dir: " << gg->INPUTFILEdir << endl; 
+//cout << "INP dir: " << g->INPUTFILEdir << endl; 
 
 opath=inpath.parent_path().parent_path();
 opath/="";
 string updir = opath.string();
 
 
-tstr = gg->POLICYFILE;
+tstr = g->POLICYFILE;
 if (tstr.compare("")==0)
-    gg->POLICYFILE = gg->INPUTFILEdir+"policy_settings.txt";
+    g->POLICYFILE = g->INPUTFILEdir+"policy_settings.txt";
 else
-    gg->POLICYFILE = gg->INPUTFILEdir+tstr;
+    g->POLICYFILE = g->INPUTFILEdir+tstr;
 
-/*string extstr=gg->POLICYFILE;
+/*string extstr=g->POLICYFILE;
 pos = extstr.find_last_of('\\');
 
 if ( pos != string::npos)
@@ -331,122 +328,154 @@ if (pos==string::npos){
     else ext =  extstr.substr(pos+15,pos1-pos-15) ;
 }
 //*/
-string ext = string("") + "_" + gg->Scenario;
+string ext = string("") + "_" + g->Scenario;
 
 tstr = optionsdata["OUTPUTFILE"];
 
 if ((tstr.compare("\r") == 0) || tstr.compare("=")==0) 
-   gg->OUTPUTFILE = updir + "outputfiles"+ ext + "/";
+   g->OUTPUTFILE = updir + "outputfiles"+ ext + "/";
 else {
    opath.assign(tstr); 
    opath/="";
-   gg->OUTPUTFILE=opath.string();
+   g->OUTPUTFILE=opath.string();
 }
 
 //TEST
-//cout << tstr << ": OUTP dir: " << gg->OUTPUTFILE << endl; 
+//cout << tstr << ": OUTP dir: " << g->OUTPUTFILE << endl; 
 
-gg->FARMOUTPUT = optionsdata["FARMOUTPUT"].compare("true") == 0 ? true : false;
-gg->SECTOROUTPUT = optionsdata["SECTOROUTPUT"].compare("true") == 0 ? true : false;
+g->FARMOUTPUT = optionsdata["FARMOUTPUT"].compare("true") == 0 ? true : false;
+g->SECTOROUTPUT = optionsdata["SECTOROUTPUT"].compare("true") == 0 ? true : false;
 
 //---  Region dependent Globals ------------
 
 //Standard: false, Sweden: true (calf and milk quota market)
-gg->SWEDEN   =  (optionsdata["SWEDEN"]).compare("true")==0 ? true : false;
+g->SWEDEN   =  (optionsdata["SWEDEN"]).compare("true")==0 ? true : false;
 
 // flase means the settings for Vsterbotton are used. THis is only relevant if Sweden is true.
-gg->JOENKEPING   =  optionsdata["JOENKEPING"].compare("true")==0 ? true : false;
+g->JOENKEPING   =  optionsdata["JOENKEPING"].compare("true")==0 ? true : false;
 
 //Standard: false, CZ, Vsterbotten, Jnkping: true
-gg->ENV_MODELING = optionsdata["ENV_MODELING"].compare("true")==0 ? true : false;
+g->ENV_MODELING = optionsdata["ENV_MODELING"].compare("true")==0 ? true : false;
 
 //true only for regions with various soil qualities of arable and/or grassland, like OPR.
 //If true, then shares of soil types will be varried among the farms
-gg->SOIL_TYPE_VARIATION   = optionsdata["SOIL_TYPE_VARIATION"].compare("true")==0 ? true : false;
+g->SOIL_TYPE_VARIATION   = optionsdata["SOIL_TYPE_VARIATION"].compare("true")==0 ? true : false;
 
 //Standard: false, Brittany: true
-gg->OLD_LAND_RELEASING_PROCESS   = optionsdata["OLD_LAND_RELEASING_PROCESS"].compare("true")==0 ? true : false;
+g->OLD_LAND_RELEASING_PROCESS   = optionsdata["OLD_LAND_RELEASING_PROCESS"].compare("true")==0 ? true : false;
 
-gg->OLD_LAND_RENTING_PROCESS = optionsdata["OLD_LAND_RENTING_PROCESS"].compare("true") == 0 ? true : false;
+g->OLD_LAND_RENTING_PROCESS = optionsdata["OLD_LAND_RENTING_PROCESS"].compare("true") == 0 ? true : false;
 
 //standard: true, OPR false farm areas are initialised as a circle around the farm  they search
 //for the plot with the lowest costs, however this only matters when transaction costs are considered
-gg->WEIGHTED_PLOT_SEARCH   =   optionsdata["WEIGHTED_PLOT_SEARCH"].compare("true")==0 ? true : false;
+g->WEIGHTED_PLOT_SEARCH   =   optionsdata["WEIGHTED_PLOT_SEARCH"].compare("true")==0 ? true : false;
+
+//Standard: false, true saves the sorted lists of free plots of each farm in large regions;
+//of plots with equal costs the one with the lowest id is rented
+g->INDEXED_PLOT_SEARCH   =   optionsdata["INDEXED_PLOT_SEARCH"].compare("true")==0 ? true : false;
+
+//Standard: false, true stores the plot data along the Z-order curve so that
+//neighbouring plots are close in memory; results do not change
+g->ZORDER_PLOT_LAYOUT   =   optionsdata["ZORDER_PLOT_LAYOUT"].compare("true")==0 ? true : false;
+
+//Standard: false, true orders the farms by the position of their farmstead
+//along the Z-order curve; the farms then act in a different order
+g->ZORDER_FARM_LIST   =   optionsdata["ZORDER_FARM_LIST"].compare("true")==0 ? true : false;
 
 //Standard: false, CZ, Lithuania, Slovakia: true
-gg->AGE_DEPENDENT   =  optionsdata["AGE_DEPENDENT"].compare("true")==0 ? true : false;
+g->AGE_DEPENDENT   =  optionsdata["AGE_DEPENDENT"].compare("true")==0 ? true : false;
 
 //Standard: false, true is necessary for Saxony, Hohenlohe, Brittany and CZ because here we have
 //different input files to calculate the modulation within the LP-model
-gg->LP_MOD   =  optionsdata["LP_MOD"].compare("true")==0 ? true : false;
+g->LP_MOD   =  optionsdata["LP_MOD"].compare("true")==0 ? true : false;
+
+//Standard: false, true: the MIPs probing the value of additional land start
+//from the basis and the solution of the preceding MIP of the farm
+g->LP_WARM_START   =  optionsdata["LP_WARM_START"].compare("true")==0 ? true : false;
+
+//Standard: false, true: the rent offers of a farm in a renting round are answered from a
+//land value function sampled at 1 and PLOTSN additional plots of each soil type, other
+//premium entitlements from one more MIP with additional direct payment (not with HAS_SOILSERVICE)
+g->LAND_VALUE_FUNCTION   =  optionsdata["LAND_VALUE_FUNCTION"].compare("true")==0 ? true : false;
+
+//Standard: false, true: a farm MIP whose LP relaxation is integral (e.g. all investments
+//fixed to zero in the production MIP) and whose rounded solution keeps all rows is solved by the
+//simplex alone, without branch and bound; otherwise the branch and bound runs as without the option
+g->LP_RELAXATION_FIRST   =  optionsdata["LP_RELAXATION_FIRST"].compare("true")==0 ? true : false;
+
+//Standard: 0, memory cap (MB) of the cache of solved farm MIPs shared by all farms, 0: no cache;
+//not used for the solves of LP_WARM_START and LP_RELAXATION_FIRST, which depend on the previous solve
+string mipcache = optionsdata["MIP_CACHE_MB"];
+if (mipcache.compare("")!=0)
+	g->MIP_CACHE_MB = atoi(mipcache.c_str());
+
+//Standard: false, true: one line per farm MIP solve in mip_log.csv and summaries per
+//phase and farm name in mip_phases.csv and mip_farms.csv of the output directory
+g->MIP_LOG   =  optionsdata["MIP_LOG"].compare("true")==0 ? true : false;
 
 //Attention, it is only differentiated between IF   =   1 and CF   =   3. In the input-files of Hohenlohe, Saxony,
 //OPR and Brittany more legal types are defined. In Brittany and Saxony CF   =   2. To changes this search above for "Legal_types"
-gg->CALC_LEGAL_TYPES   =  optionsdata["CALC_LEGAL_TYPES"].compare("true")==0 ? true : false;
+g->CALC_LEGAL_TYPES   =  optionsdata["CALC_LEGAL_TYPES"].compare("true")==0 ? true : false;
 
 //===================================================
 //New 04.04.2011 Soilservice
 //====================================================
-gg->HAS_SOILSERVICE=optionsdata["HAS_SOILSERVICE"].compare("true")==0 ? true : false;	
-gg->TECH_DEVELOP = atof(optionsdata["TECH_DEVELOP"].c_str());
-gg->CARBON_MIN = atof(optionsdata["CARBON_MIN"].c_str());
-gg->CARBON_MAX = atof(optionsdata["CARBON_MAX"].c_str());
+g->HAS_SOILSERVICE=optionsdata["HAS_SOILSERVICE"].compare("true")==0 ? true : false;	
+g->TECH_DEVELOP = atof(optionsdata["TECH_DEVELOP"].c_str());
+g->CARBON_MIN = atof(optionsdata["CARBON_MIN"].c_str());
+g->CARBON_MAX = atof(optionsdata["CARBON_MAX"].c_str());
 
 //====================================================
 //New  15.03.2011
 //====================================================
-    gg->REGIONAL_DECOUPLING=atoi(optionsdata["REGIONAL_DECOUPLING"].c_str());
-    gg->FULLY_DECOUPLING=atoi(optionsdata["FULLY_DECOUPLING"].c_str());
-    gg->FARMSPECIFIC_DECOUPLING=atoi(optionsdata["FARMSPECIFIC_DECOUPLING"].c_str());
-    gg->REGIONAL_DECOUPLING_SWITCH=atoi(optionsdata["REGIONAL_DECOUPLING_SWITCH"].c_str());
-    gg->FULLY_DECOUPLING_SWITCH=atoi(optionsdata["FULLY_DECOUPLING_SWITCH"].c_str());
-    gg->FARMSPECIFIC_DECOUPLING_SWITCH=atoi(optionsdata["FARMSPECIFIC_DECOUPLING_SWITCH"].c_str());
-    //gg->WITHDRAWFACTOR = atof(optionsdata["WITHDRAWFACTOR"].c_str());
-    gg->AVERAGE_OFFER_BUFFER_SIZE=atoi(optionsdata["AVERAGE_OFFER_BUFFER_SIZE"].c_str());
+    g->REGIONAL_DECOUPLING=atoi(optionsdata["REGIONAL_DECOUPLING"].c_str());
+    g->FULLY_DECOUPLING=atoi(optionsdata["FULLY_DECOUPLING"].c_str());
+    g->FARMSPECIFIC_DECOUPLING=atoi(optionsdata["FARMSPECIFIC_DECOUPLING"].c_str());
+    g->REGIONAL_DECOUPLING_SWITCH=atoi(optionsdata["REGIONAL_DECOUPLING_SWITCH"].c_str());
+    g->FULLY_DECOUPLING_SWITCH=atoi(optionsdata["FULLY_DECOUPLING_SWITCH"].c_str());
+    g->FARMSPECIFIC_DECOUPLING_SWITCH=atoi(optionsdata["FARMSPECIFIC_DECOUPLING_SWITCH"].c_str());
+    //g->WITHDRAWFACTOR = atof(optionsdata["WITHDRAWFACTOR"].c_str());
+    g->AVERAGE_OFFER_BUFFER_SIZE=atoi(optionsdata["AVERAGE_OFFER_BUFFER_SIZE"].c_str());
 
-    gg->USE_TRIANGULAR_DISTRIBUTED_MANAGEMENT_FACTOR=optionsdata["USE_TRIANGULAR_DISTRIBUTED_MANAGEMENT_FACTOR"].compare("true")==0 ? true : false;
-    gg->USE_TRIANGULAR_DISTRIBUTED_FARM_AGE=optionsdata["USE_TRIANGULAR_DISTRIBUTED_FARM_AGE"].compare("true")==0 ? true : false;
+    g->USE_TRIANGULAR_DISTRIBUTED_MANAGEMENT_FACTOR=optionsdata["USE_TRIANGULAR_DISTRIBUTED_MANAGEMENT_FACTOR"].compare("true")==0 ? true : false;
+    g->USE_TRIANGULAR_DISTRIBUTED_FARM_AGE=optionsdata["USE_TRIANGULAR_DISTRIBUTED_FARM_AGE"].compare("true")==0 ? true : false;
 
-    gg->WEIGHTED_PLOT_SEARCH_VALUE=atoi(optionsdata["WEIGHTED_PLOT_SEARCH_VALUE"].c_str());
+    g->WEIGHTED_PLOT_SEARCH_VALUE=atoi(optionsdata["WEIGHTED_PLOT_SEARCH_VALUE"].c_str());
 
-    gg->USE_VARIABLE_PRICE_CHANGE=optionsdata["USE_VARIABLE_PRICE_CHANGE"].compare("true")==0 ? true : false;
+    g->USE_VARIABLE_PRICE_CHANGE=optionsdata["USE_VARIABLE_PRICE_CHANGE"].compare("true")==0 ? true : false;
 
-    gg->NO_SUCCESSOR_BY_RANDOM=optionsdata["NO_SUCCESSOR_BY_RANDOM"].compare("true")==0 ? true : false;
-    gg->ASSOCIATE_ACTIVITIES=optionsdata["ASSOCIATE_ACTIVITIES"].compare("true")==0 ? true : false;
-    gg->CALCULATE_CONTIGUOUS_PLOTS=optionsdata["CALCULATE_CONTIGUOUS_PLOTS"].compare("true")==0 ? true : false;
-    gg->USE_HISTORICAL_CONTIGUOUS_PLOTS=optionsdata["USE_HISTORICAL_CONTIGUOUS_PLOTS"].compare("true")==0 ? true : false;
+    g->NO_SUCCESSOR_BY_RANDOM=optionsdata["NO_SUCCESSOR_BY_RANDOM"].compare("true")==0 ? true : false;
+    g->ASSOCIATE_ACTIVITIES=optionsdata["ASSOCIATE_ACTIVITIES"].compare("true")==0 ? true : false;
+    g->CALCULATE_CONTIGUOUS_PLOTS=optionsdata["CALCULATE_CONTIGUOUS_PLOTS"].compare("true")==0 ? true : false;
+    g->USE_HISTORICAL_CONTIGUOUS_PLOTS=optionsdata["USE_HISTORICAL_CONTIGUOUS_PLOTS"].compare("true")==0 ? true : false;
 
-    gg->FIX_PRICES=optionsdata["FIX_PRICES"].compare("true")==0 ? true : false;
+    g->FIX_PRICES=optionsdata["FIX_PRICES"].compare("true")==0 ? true : false;
 
     /////////////////////////////////////
 
-    gg->PRINT_SEC_RES=optionsdata["PRINT_SEC_RES"].compare("true")==0 ? true : false;
-    gg->PRINT_SEC_PRICE=optionsdata["PRINT_SEC_PRICE"].compare("true")==0 ? true : false;
-    gg->PRINT_SEC_EXP_PRICE=optionsdata["PRINT_SEC_EXP_PRICE"].compare("true")==0 ? true : false;
-    gg->PRINT_SEC_COSTS=optionsdata["PRINT_SEC_COSTS"].compare("true")==0 ? true : false;
-    gg->PRINT_SEC_COND=optionsdata["PRINT_SEC_COND"].compare("true")==0 ? true : false;
-    gg->PRINT_FARM_RES=optionsdata["PRINT_FARM_RES"].compare("true")==0 ? true : false;
-    gg->PRINT_FARM_INV=optionsdata["PRINT_FARM_INV"].compare("true")==0 ? true : false;
-    gg->PRINT_FARM_PROD=optionsdata["PRINT_FARM_PROD"].compare("true")==0 ? true : false;
-    gg->PRINT_FARM_COSTS=optionsdata["PRINT_FARM_COSTS"].compare("true")==0 ? true : false;
-    gg->PRINT_CONT_PLOTS=optionsdata["PRINT_CONT_PLOTS"].compare("true")==0 ? true : false;
-
-    gg->PRINT_TAC=optionsdata["PRINT_TAC"].compare("true")==0 ? true : false;
-    gg->PRINT_VA=optionsdata["PRINT_VA"].compare("true")==0 ? true : false;
-    gg->PRINT_POLICY=optionsdata["PRINT_POLICY"].compare("true")==0 ? true : false;
+    g->PRINT_SEC_RES=optionsdata["PRINT_SEC_RES"].compare("true")==0 ? true : false;
+    g->PRINT_SEC_PRICE=optionsdata["PRINT_SEC_PRICE"].compare("true")==0 ? true : false;
+    g->PRINT_SEC_EXP_PRICE=optionsdata["PRINT_SEC_EXP_PRICE"].compare("true")==0 ? true : false;
+    g->PRINT_SEC_COSTS=optionsdata["PRINT_SEC_COSTS"].compare("true")==0 ? true : false;
+    g->PRINT_SEC_COND=optionsdata["PRINT_SEC_COND"].compare("true")==0 ? true : false;
+    g->PRINT_FARM_RES=optionsdata["PRINT_FARM_RES"].compare("true")==0 ? true : false;
+    g->PRINT_FARM_INV=optionsdata["PRINT_FARM_INV"].compare("true")==0 ? true : false;
+    g->PRINT_FARM_PROD=optionsdata["PRINT_FARM_PROD"].compare("true")==0 ? true : false;
+    g->PRINT_FARM_COSTS=optionsdata["PRINT_FARM_COSTS"].compare("true")==0 ? true : false;
+    g->PRINT_CONT_PLOTS=optionsdata["PRINT_CONT_PLOTS"].compare("true")==0 ? true : false;
+
+    g->PRINT_TAC=optionsdata["PRINT_TAC"].compare("true")==0 ? true : false;
+    g->PRINT_VA=optionsdata["PRINT_VA"].compare("true")==0 ? true : false;
+    g->PRINT_POLICY=optionsdata["PRINT_POLICY"].compare("true")==0 ? true : false;
 
 	//derived from replication
-    //gg->INIT_OUTPUT=optionsdata["INIT_OUTPUT"].compare("true")==0 ?  true : false;
+    //g->INIT_OUTPUT=optionsdata["INIT_OUTPUT"].compare("true")==0 ?  true : false;
 return;
 }
 
-void options(string idir){
-//	if (idir[idir.length()-1]!='\\' )
-//		optiondir = idir + '\\';
-//	else 
-//		optiondir= idir;
-    optiondir=idir+"/";
-    readoptions();
-    setoptions();
+void options(RegGlobalsInfo* g){
+    map<string,string> optionsdata;
+    readoptions(g, optionsdata);
+    setoptions(g, optionsdata);
     return;
 }
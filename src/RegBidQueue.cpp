@@ -0,0 +1,89 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// RegBidQueue.cpp
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include "RegBidQueue.h"
+
+void
+RegBidQueue::init(const vector<RegFarmInfo*>& f, int types) {
+    farms = f;
+    heaps.assign(types, priority_queue<Bid>());
+    version.assign(types, vector<unsigned long>(farms.size(), 0));
+    dirty.assign(types, vector<bool>(farms.size(), true));
+    dirty_farms.assign(types, vector<int>());
+    wanting.assign(types, unordered_map<RegPlotInfo*, vector<int> >());
+    for (int t=0;t<types;t++)
+        for (unsigned int i=0;i<farms.size();i++)
+            dirty_farms[t].push_back(i);
+}
+
+void
+RegBidQueue::markDirty(int i, int type) {
+    if (dirty[type][i])
+        return;
+    dirty[type][i] = true;
+    dirty_farms[type].push_back(i);
+}
+
+vector<int>
+RegBidQueue::changed(int type) {
+    vector<int> c;
+    c.swap(dirty_farms[type]);
+    sort(c.begin(), c.end());
+    for (unsigned int k=0;k<c.size();k++)
+        dirty[type][c[k]] = false;
+    return c;
+}
+
+void
+RegBidQueue::setOffer(int i, int type, double offer, RegPlotInfo* wanted) {
+    unsigned long v = ++version[type][i];
+    if (offer > 0) {
+        Bid b;
+        b.offer = offer;
+        b.farm = i;
+        b.version = v;
+        heaps[type].push(b);
+    }
+    if (wanted)
+        wanting[type][wanted].push_back(i);
+}
+
+void
+RegBidQueue::invalidateFarm(int i) {
+    for (unsigned int t=0;t<heaps.size();t++)
+        markDirty(i, t);
+}
+
+void
+RegBidQueue::plotRented(RegPlotInfo* p, int type) {
+    unordered_map<RegPlotInfo*, vector<int> >::iterator it = wanting[type].find(p);
+    if (it == wanting[type].end())
+        return;
+    for (unsigned int k=0;k<it->second.size();k++)
+        markDirty(it->second[k], type);
+    wanting[type].erase(it);
+}
+
+int
+RegBidQueue::top(int type, double& offer) {
+    priority_queue<Bid>& h = heaps[type];
+    while (!h.empty() && h.top().version != version[type][h.top().farm])
+        h.pop();
+    offer = 0;
+    if (h.empty())
+        return -1;
+    offer = h.top().offer;
+    return h.top().farm;
+}
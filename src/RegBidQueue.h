@@ -0,0 +1,82 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+//---------------------------------------------------------------------------
+// RegBidQueue.h
+//---------------------------------------------------------------------------
+#ifndef RegBidQueueH
+#define RegBidQueueH
+
+#include <vector>
+#include <queue>
+#include <unordered_map>
+
+using namespace std;
+
+class RegFarmInfo;
+class RegPlotInfo;
+
+/** RegBidQueue class.
+    @short rent offers of the farms per soil type in the old renting process.
+    In a round of LandAllocation() a farm bids the same as in the round
+    before unless it rented a plot (its land values are computed again) or
+    the plot it wants of the type was rented by another farm. Only these
+    farms are asked again; the other offers are kept in a max heap per soil
+    type. top() returns the farm rentOnePlot() picked when it compared all
+    offers in the order of FarmList: the highest positive offer, the first
+    farm of FarmList among equal offers.
+*/
+class RegBidQueue {
+public:
+    /// @param farms FarmList, its order decides equal offers
+    void init(const vector<RegFarmInfo*>& farms, int types);
+    const vector<RegFarmInfo*>& getFarms() const {
+        return farms;
+    }
+    /// farms to ask for their offer of type, in the order of FarmList
+    vector<int> changed(int type);
+    /// new offer of farm i for its wanted plot of type
+    void setOffer(int i, int type, double offer, RegPlotInfo* wanted);
+    /// farm i rented a plot, its offers of all types are asked again
+    void invalidateFarm(int i);
+    /// the offer of farm i of type is asked again
+    void invalidateOffer(int i, int type) {
+        markDirty(i, type);
+    }
+    /// plot p was rented, farms wanting it bid for another plot
+    void plotRented(RegPlotInfo* p, int type);
+    /// index of the farm with the highest positive offer of type or -1
+    int top(int type, double& offer);
+private:
+    struct Bid {
+        double offer;
+        int farm;
+        /// version of the offer, older entries are skipped
+        unsigned long version;
+        bool operator<(const Bid& b) const {
+            if (offer != b.offer)
+                return offer < b.offer;
+            return farm > b.farm;
+        }
+    };
+    vector<RegFarmInfo*> farms;
+    vector<priority_queue<Bid> > heaps;
+    /// version of the current offer per type and farm
+    vector<vector<unsigned long> > version;
+    vector<vector<bool> > dirty;
+    vector<vector<int> > dirty_farms;
+    /// farms per wanted plot; entries may be outdated, they only cost a request
+    vector<unordered_map<RegPlotInfo*, vector<int> > > wanting;
+    void markDirty(int i, int type);
+};
+
+#endif
@@ -164,7 +164,7 @@ RegDataInfo::initialisation(vector<RegInvestObjectInfo>& invest_cat,
     string dirname = ppath.string();
     
     if (!fs::exists(ppath)) {
-      if (!create_directory(ppath)) {
+      if (!fs::create_directories(ppath)) {
             cerr << "ERROR: " << g->OUTPUTFILE.c_str() << " can not be created ! " << endl;
             exit(2);
       }
@@ -703,8 +703,8 @@ RegDataInfo::printSectorResults(const RegSectorResultsInfo& sector,
 
  //DCX
     bool ok = g->stdNameIndexs.find("MANSELL")!=end(g->stdNameIndexs);
-	sector_values.push_back(ok?product_cat[g->stdNameIndexs["MANSELL"]].getPriceExpectation():0);
-    sector_values.push_back(ok?product_cat[g->stdNameIndexs["MANBUY"]].getPriceExpectation():0);
+	sector_values.push_back(ok?product_cat[g->getStdNameIndex("MANSELL")].getPriceExpectation():0);
+    sector_values.push_back(ok?product_cat[g->getStdNameIndex("MANBUY")].getPriceExpectation():0);
 	
     for (int i=0;i<g->NO_OF_SOIL_TYPES;i++) {
         sector_values.push_back( sector.total_rent_of_type[i]         );
@@ -821,7 +821,7 @@ RegDataInfo::initCondensedSectorOutput() {
     condsecout.setf(ios_base::fmtflags(0), ios_base::floatfield);
     condsecout.precision(10);
     condsecout.setf(ios_base::left, ios_base::adjustfield);
-    if (g->V==0) {
+    if (g->INIT_OUTPUT) {
     condsecout << "scenario\t"
     << "replication\t"
     << "iteration\t"
@@ -867,7 +867,7 @@ void
 RegDataInfo::initLegalTypeOutput(vector<RegInvestObjectInfo>& invest_cat,vector<RegProductInfo>& product_cat) {
 //DCX   NICHT mit echten  sector_names verwechselt !
 		vector<string> sector_names;
-	if (g->V==0) {
+	if (g->INIT_OUTPUT) {
         string part2="legal_type.dat";
         string filename=g->OUTPUTFILE +part2;
 
@@ -1010,8 +1010,8 @@ RegDataInfo::printLegalTypeResults(const RegSectorResultsInfo& sector,vector<Reg
             sector_values.push_back( sector_type[z]->real_sunk_costs_labour    );
 //DCX
             bool ok = g->stdNameIndexs.find("MANSELL")!=end(g->stdNameIndexs);
-            sector_values.push_back(ok ? product_cat[g->stdNameIndexs["MANSELL"]].getPriceExpectation():0 );
-            sector_values.push_back(ok ? product_cat[g->stdNameIndexs["MANBUY"]].getPriceExpectation():0 );
+            sector_values.push_back(ok ? product_cat[g->getStdNameIndex("MANSELL")].getPriceExpectation():0 );
+            sector_values.push_back(ok ? product_cat[g->getStdNameIndex("MANBUY")].getPriceExpectation():0 );
             for (int i=0;i<g->NO_OF_SOIL_TYPES;i++) {
                 sector_values.push_back( sector_type[z]->total_rent_of_type[i]         );
             }
@@ -1371,12 +1371,12 @@ RegDataInfo::cacheFarmResults(const RegFarmInfo* farm,
 
     // SUBSIDIES
 	if(g->LP_MOD) {
-    	res.push_back(farm->getUnitsOfProduct(g->stdNameIndexs["COUPLED_PREM_UNMOD"]) );
-    	res.push_back(farm->getUnitsOfProduct(g->stdNameIndexs["DECOUPLED_PREM_UNMOD"]) );
-    	res.push_back(farm->getUnitsOfProduct(g->stdNameIndexs["TOTAL_PREM_MODULATED"]) );
+    	res.push_back(farm->getUnitsOfProduct(g->getStdNameIndex("COUPLED_PREM_UNMOD")) );
+    	res.push_back(farm->getUnitsOfProduct(g->getStdNameIndex("DECOUPLED_PREM_UNMOD")) );
+    	res.push_back(farm->getUnitsOfProduct(g->getStdNameIndex("TOTAL_PREM_MODULATED")) );
 	} else {
     	res.push_back(farm->getModulatedIncomePaymentFarm() );
-    	res.push_back(farm->getUnitsOfProduct(g->stdNameIndexs["PREMIUM"]) );
+    	res.push_back(farm->getUnitsOfProduct(g->getStdNameIndex("PREMIUM")) );
 	}
 
     // LAND
@@ -29,6 +29,8 @@ RegEnvInfo::RegEnvInfo(RegGlobalsInfo* G):g(G) {
 
 void
 RegEnvInfo::initEnv() {
+    const struct globdata& globdata = g->inputs->globdata;
+    const struct envdata& envdata = g->inputs->envdata;
   if (g->ENV_MODELING) {
         nHabitats = envdata.biohabs.size();
         zCoef = envdata.zcoef;
@@ -38,7 +40,7 @@ RegEnvInfo::initEnv() {
         cCoeffByHabitat.resize(nHabitats);
 
         {int i=0;
-        for (vector<biohab>::iterator it = envdata.biohabs.begin();
+        for (vector<biohab>::const_iterator it = envdata.biohabs.begin();
                 it != envdata.biohabs.end(); it++) {
             habitatLabels.push_back((*it).name);
             speciesByHabitat[i++]= (*it).value;
@@ -64,13 +66,13 @@ RegEnvInfo::initEnv() {
 
             no_acts.push_back(envdata.groups[i].acts.size());
 
-            {vector < act > :: iterator it= envdata.groups[i].acts.begin();
+            {vector < act > :: const_iterator it= envdata.groups[i].acts.begin();
             for (int j=0 ;j<no_acts[i];j++) {
                 sacts.push_back((*it).name);
                 it++;
             }}
 
-            {vector <act> :: iterator it= envdata.groups[i].acts.begin() ;
+            {vector <act> :: const_iterator it= envdata.groups[i].acts.begin() ;
             for (int j=0;j<no_acts[i];j++) {
                 q.push_back((*it).q);
                 it++;
@@ -15,6 +15,7 @@
 #include "RegPlot.h"
 #include <iomanip>
 #include <map>
+#include <set>
 #include "random.h"
 
 using namespace std;
@@ -43,9 +44,9 @@ void RegFarmInfo::initCarbons(vector<double> mean, vector<double> var) { //var -
 
 	for (int i = 0; i<nsoil; ++i) {
 		for (unsigned j=0; j<pplots[i].size(); ++j) {
-			double x =  rand_normal(mean[i],var[i]);
+			double x =  g->mtrand.rand_normal(mean[i],var[i]);
 			while ( (x< g->CARBON_MIN )||(x>g->CARBON_MAX))
-				x = rand_normal(mean[i],var[i]);
+				x = g->mtrand.rand_normal(mean[i],var[i]);
 			pplots[i][j]->setCarbon(x); // *g->PLOT_SIZE); //x is c-value per ha ?
 		}
 	}
@@ -223,9 +224,14 @@ RegFarmInfo::RegFarmInfo(RegRegionInfo *reg,
         lp_result_with_new_plot_of_type.push_back(0);
         delta_profit_of_type.push_back(0);
         wanted_plot_of_type.push_back(RegPlotInformationInfo());
+        land_value_pe.push_back(0);
+        land_value_plots.push_back(0);
+        land_value_rented.push_back(0);
 
     }
+    free_plots_released=0;
     actual=false;
+    resetLandValue();
 
     assets=0;
     land_assets = 0;
@@ -239,6 +245,7 @@ RegFarmInfo::RegFarmInfo(RegRegionInfo *reg,
     farm_class_change = false;
     farm_type = pop;
     farm_id = number;
+    random_streams.setFarm(number);
     farm_age = 0;
     full_time = true;
     legal_type = farmerwerbsform;
@@ -315,20 +322,20 @@ RegFarmInfo::RegFarmInfo(RegRegionInfo *reg,
     double upper_border=g->UPPER_BORDER;
 
 	if (g->USE_TRIANGULAR_DISTRIBUTED_MANAGEMENT_FACTOR) {
-		management_coefficient = g->triangular("MGMTCOEFF", lower_border, lower_border + (upper_border - lower_border) / 2, upper_border);
+		management_coefficient = g->triangular(RAND_GEN::MGMTCOEFF, lower_border, lower_border + (upper_border - lower_border) / 2, upper_border, &random_streams);
     } else {
         //management_coefficient = lower_border + (upper_border-lower_border)*((double)randlong()/mtRandMax);//RAND_MAX);
 		double r;
-		string name = "MGMTCOEFF";
+		RAND_GEN name = RAND_GEN::MGMTCOEFF;
 		
 		if (g->ManagerDistribType != DISTRIB_TYPE::NORMAL) {
-			r = g->getRandomReal(name, g->uni_real_distrib_mgmtCoeff);
+			r = g->getRandomReal(name, g->uni_real_distrib_mgmtCoeff, &random_streams);
 			management_coefficient = lower_border + (upper_border - lower_border)*r;
 		}
 		else {
-			r = g->getRandomNormal(name, g->normal_distr);
+			r = g->getRandomNormal(name, g->normal_distr, &random_streams);
 			while (r < lower_border || r > upper_border)
-				r = g->getRandomNormal(name, g->normal_distr);
+				r = g->getRandomNormal(name, g->normal_distr, &random_streams);
 			management_coefficient = r;
 		}
 		//cout << mean<<"\t"<<stddev<<"\t"<< r << endl;
@@ -431,6 +438,7 @@ RegFarmInfo* RegFarmInfo::clone(RegGlobalsInfo* G,RegRegionInfo * reg,
     (*n).farm_class_change=farm_class_change;
     (*n).farm_type=farm_type;
     (*n).farm_id=farm_id;
+    (*n).random_streams=random_streams;
     (*n).farm_colour=farm_colour;
     (*n).farm_age=farm_age;
     (*n).full_time=full_time;
@@ -451,6 +459,18 @@ RegFarmInfo* RegFarmInfo::clone(RegGlobalsInfo* G,RegRegionInfo * reg,
     (*n).lp_result_with_new_plot_of_type=lp_result_with_new_plot_of_type;
     (*n).delta_profit_of_type=delta_profit_of_type;
     (*n).wanted_plot_of_type=wanted_plot_of_type;
+    (*n).land_value_pe=land_value_pe;
+    (*n).land_value_plots=land_value_plots;
+    (*n).land_value_rented=land_value_rented;
+    (*n).land_value_payment_actual=land_value_payment_actual;
+    (*n).land_value_payment_slope=land_value_payment_slope;
+    (*n).free_plots_released=free_plots_released;
+    (*n).farmstead_search=farmstead_search;
+    vector< vector<RegPlotInformationInfo> >& free_plots=(*n).farmstead_search.free_plots;
+    for (unsigned int i=0;i<free_plots.size();i++) {
+        for (unsigned int j=0;j<free_plots[i].size();j++)
+            free_plots[i][j].plot=(*n).region->plots[free_plots[i][j].plot->getId()];
+    }
     for (unsigned int i=0;i<wanted_plot_of_type.size();i++) {
         if (wanted_plot_of_type[i].plot!=NULL)
             (*n).wanted_plot_of_type[i].plot=(*n).region->plots[wanted_plot_of_type[i].plot->getId()];
@@ -598,12 +618,12 @@ RegFarmInfo::updateCosts() {
     FarmProductList->updateCosts(management_coefficient);
 }
 
-double RegFarmInfo::getRandomNormalRange(string nm, std::normal_distribution<>& distr, 
+double RegFarmInfo::getRandomNormalRange(RAND_GEN nm, std::normal_distribution<>& distr, 
 	double low, double high) {
-	double r = g->getRandomNormal(nm, distr);
+	double r = g->getRandomNormal(nm, distr, &random_streams);
 	while (r <low || r >high) {
 		//cout << r << endl;
-		r = g->getRandomNormal(nm, distr);
+		r = g->getRandomNormal(nm, distr, &random_streams);
 	}
 	return r;
 }
@@ -620,20 +640,19 @@ RegFarmInfo::setAsynchronousFarmAge() {
 	if (g->ManagerDemographics || g->YoungFarmer) {
 		double r;
 		if (legal_type == 2) {
-			r = getRandomNormalRange("DEMOGCF", g->CF_age_normal_distr,lb,ub);
+			r = getRandomNormalRange(RAND_GEN::DEMOGCF, g->CF_age_normal_distr,lb,ub);
 		}
 		else {
-			r = getRandomNormalRange("DEMOGFF", g->FF_age_normal_distr, lb, ub);
+			r = getRandomNormalRange(RAND_GEN::DEMOGFF, g->FF_age_normal_distr, lb, ub);
 		}
 		ran = (int)(r + 0.5);
 	}else {
 		if (g->USE_TRIANGULAR_DISTRIBUTED_FARM_AGE) {
-			ran = static_cast<int>(g->triangular("FARMAGE", 1, 12, g->GENERATION_CHANGE));
+			ran = static_cast<int>(g->triangular(RAND_GEN::FARMAGE, 1, 12, g->GENERATION_CHANGE, &random_streams));
 		}
 		else {
 			int r;
-			string name = "FARMAGE";
-			r = g->getRandomInt(name, g->uni_int_distrib_farmAge);
+			r = g->getRandomInt(RAND_GEN::FARMAGE, g->uni_int_distrib_farmAge, &random_streams);
 
 			ran = r;// randlong() % g->GENERATION_CHANGE;
 			//cout <<"fage: "<< ran << endl;
@@ -652,7 +671,7 @@ RegFarmInfo::setAsynchronousFarmAge() {
     // initial assets
     assets += land_assets;
 
-    FarmInvestList->setAsynchronousInvestAge(farm_age,&assets,&liquidity,&lt_borrowed_capital,eqinterest,rel_invest_age);
+    FarmInvestList->setAsynchronousInvestAge(farm_age,&assets,&liquidity,&lt_borrowed_capital,eqinterest,rel_invest_age,&random_streams);
     labour->setLabourCapacity(labour->getFamilyLabour()
                               +FarmInvestList->getLabourSubstitution() // lab effect of invests inkl fix labour
                              );
@@ -676,27 +695,12 @@ RegFarmInfo::getInitialOwnedLand() const {
 }
 
 int RegFarmInfo::getRandomContractLength() {
-	string name = "CONTRACTLENGTHINIT";
-
-  return g->getRandomInt(name, g->uni_int_distrib_contractLengthInit);
+  return g->getRandomInt(RAND_GEN::CONTRACTLENGTHINIT, g->uni_int_distrib_contractLengthInit, &random_streams);
 }
 
 bool 
 RegFarmInfo::getInitialRentedPlot(double rent,int type) {
-	// int col0, row0, col1, row1;
-	if (g->INITIALISATION) {
-		wanted_plot = farm_plot->findMostPreferablePlotOfType(type, this).plot;
-		//	col0 = wanted_plot->getCol();
-		//	row0 = wanted_plot->getRow();
-	}
-	else {
-		wanted_plot = farm_plot->findMostPreferablePlotOfType(type).plot;
-		//	col1 = wanted_plot->getCol(); 
-		//	row1 = wanted_plot->getRow();
-	}
-	//	if (this->farm_id==0 && (col0!=col1 ||row0!=row1))
-	//	cout << farm_plot->getCol() << ", " << farm_plot->getRow() << ": \t "
-	//   	 << col0<<", "<<row0<< "  !=  " << col1 << ", "<<row1<<endl;
+	wanted_plot = region->findMostPreferablePlotOfType(farm_plot, type, this).plot;
 
 	// wanted_plot = farm_plot->findFreePlotOfType(type);
     // only enter if wanted_plot is not NULL
@@ -720,10 +724,7 @@ RegFarmInfo::getInitialRentedPlot(double rent,int type) {
 }
 bool
 RegFarmInfo::getInitialOwnedPlot(int type) {
-	if (g->INITIALISATION)
-		wanted_plot = farm_plot->findMostPreferablePlotOfType(type, this).plot;
-	else
-		wanted_plot = farm_plot->findMostPreferablePlotOfType(type).plot;
+	wanted_plot = region->findMostPreferablePlotOfType(farm_plot, type, this).plot;
 //   wanted_plot = farm_plot->findFreePlotOfType(type);
     // only enter if wanted_plot is not NULL
     // but it is free
@@ -762,17 +763,17 @@ RegFarmInfo::allokateInitialLand() {
             if (land_input_of_group[i]<initial_owned_land_of_group[i]) {
                 int t;
                 if(i==0)
-                  t=randlong()%3;
+                  t=g->mtrand.randlong()%3;
                 else
-                  t=(randlong()%2)+3;
+                  t=(g->mtrand.randlong()%2)+3;
                 getInitialOwnedPlot(t);
                 enough=false;
             } else {
                 int t;
                 if(i==0)
-                  t=randlong()%3;
+                  t=g->mtrand.randlong()%3;
                 else
-                  t=(randlong()%2)+3;
+                  t=(g->mtrand.randlong()%2)+3;
                 getInitialRentedPlot(initial_rent_of_type[t]*g->PLOT_SIZE,t);
                 enough=false;
             }
@@ -841,13 +842,38 @@ RegFarmInfo::closeDown() {
 // RENTING PROCESS
 //////////////////
 
+void
+RegFarmInfo::initPlotSearch() {
+    if (g->FAST_PLOT_SEARCH)
+        farmstead_search.plot_p.assign(g->NO_OF_SOIL_TYPES,0);
+}
+
+void
+RegFarmInfo::resetPlotPointer() {
+    for (unsigned int i=0;i<farmstead_search.plot_p.size();i++)
+        farmstead_search.plot_p[i]=0;
+}
+
+void
+RegFarmInfo::clearFreePlots() {
+    farmstead_search.free_plots.assign(g->NO_OF_SOIL_TYPES, vector<RegPlotInformationInfo>());
+    farmstead_search.uniform_pe.assign(g->NO_OF_SOIL_TYPES, false);
+    farmstead_search.free_plot_slot.clear();
+}
+
 void
 RegFarmInfo::newRentingProcess(int period) {
-    if (g->WEIGHTED_PLOT_SEARCH)
-        farm_plot->initFreePlots(this);
+    if (g->WEIGHTED_PLOT_SEARCH) {
+        if (region->usePlotIndex())
+            clearFreePlots();
+        else
+            farm_plot->initFreePlots(this);
+        free_plots_released=region->getReleasedPlots();
+    }
     if (g->FAST_PLOT_SEARCH)
-        farm_plot->resetPlotPointer();
+        resetPlotPointer();
     actual=false;
+    resetLandValue();
     first_time = true;
     if (period > 0) {
         // TF wirksam zu Beginn von neuer Periode
@@ -890,9 +916,19 @@ double RegFarmInfo::get_beta() const {
 
 void
 RegFarmInfo::demandForLand(RegPlotInfo* p) {
+    if (hasLandValue(1) && (!actual || p->getPaymentEntitlement()!=cache_premium_of_type[p->getSoilType()])) {
+        double pe = p->getPaymentEntitlement();
+        for(int i=0;i<g->NO_OF_SOIL_TYPES;i++) {
+            cache_sp_of_type[i]=landValueGain(i,1,pe);
+            cache_premium_of_type[i]=pe;
+        }
+        actual=true;
+    }
     if (!actual || p->getPaymentEntitlement()!=cache_premium_of_type[p->getSoilType()]) {
 	
+    lp->setWarmStart(g->LP_WARM_START);
     lp_result=doLpWithPriceExpectation();
+    resetLandValue();
 	for(int i=0;i<g->NO_OF_SOIL_TYPES;i++) {
         double pe = p->getPaymentEntitlement();
         incDirectPayment(pe);
@@ -904,7 +940,11 @@ RegFarmInfo::demandForLand(RegPlotInfo* p) {
         decreaseLandCapacityOfType(i,1);
         cache_sp_of_type[i]=lp_with_new-lp_result;
         cache_premium_of_type[i]=p->getPaymentEntitlement();
+        lp_result_with_new_plot_of_type[i]=lp_with_new;
+        land_value_pe[i]=pe;
+        land_value_plots[i]=1;
     }
+        lp->setWarmStart(false);
         actual=true   ;
 
     }
@@ -919,7 +959,6 @@ RegFarmInfo::demandForLand(RegPlotInfo* p) {
     double factor = 0;
     if (g->Rent_Variation) factor = rent_beta;
     else factor = g->RENT_ADJUST_COEFFICIENT;
-    p->identifyPlotsSameStateAndFarm(farm_id);
     rent_offer = max_offer*factor;
     if (rent_offer < 0)
         rent_offer = 0;
@@ -930,6 +969,12 @@ RegFarmInfo::demandForLand(RegPlotInfo* p) {
 //////////////////////
 void
 RegFarmInfo::calculateShadowPriceForLandOfType(int type,double premium_entitlement) {
+    if (hasLandValue(type,g->PLOTSN)) {
+        delta_profit_of_type[type] = max(landValueGain(type,1,premium_entitlement),
+                                         landValueGain(type,g->PLOTSN,premium_entitlement)/(double)g->PLOTSN);
+        return;
+    }
+    lp->setWarmStart(g->LP_WARM_START);
     incDirectPayment(premium_entitlement);
     increaseLandCapacityOfType(type,1);
 	if (g->HAS_SOILSERVICE) increaseCarbonOfType(type,1);
@@ -943,6 +988,9 @@ RegFarmInfo::calculateShadowPriceForLandOfType(int type,double premium_entitleme
     decDirectPayment(premium_entitlement*g->PLOTSN);
     decreaseLandCapacityOfType(type,g->PLOTSN);
 	if (g->HAS_SOILSERVICE) decreaseCarbonOfType(type,g->PLOTSN);
+    lp->setWarmStart(false);
+    land_value_pe[type]=premium_entitlement;
+    land_value_plots[type]=g->PLOTSN;
     delta_profit_of_type[type] = max(lp_result_with_new_plot_of_type[type]-lp_result,
                                      (lp_result_with_plotsn_new_plots_of_type[type]-lp_result)/(double)g->PLOTSN);
 }
@@ -951,17 +999,22 @@ RegFarmInfo::demandForLandOfType(int type,int count) {
     // the first time 3 LPs have to be computed
     if (!actual) {
         actual=true;
-        lp->updatePaymentEntitlement();
-        lp_result=doLpWithPriceExpectation();
+        if (!hasLandValue(g->PLOTSN)) {
+            lp->updatePaymentEntitlement();
+            lp_result=doLpWithPriceExpectation();
+            resetLandValue();
+        }
 
         for (int i=0;i<g->NO_OF_SOIL_TYPES;i++) {
-            wanted_plot_of_type[i]=farm_plot->findMostPreferablePlotOfType(i);
+            wanted_plot_of_type[i]=region->findMostPreferablePlotOfType(farm_plot,i,this);
 
             if (wanted_plot_of_type[i].plot!=0) {
                 calculateShadowPriceForLandOfType(i,wanted_plot_of_type[i].pe);
             } else {
-                lp_result_with_new_plot_of_type[i] = 0;
-                lp_result_with_plotsn_new_plots_of_type[i] = 0;
+                if (!hasLandValue(i,g->PLOTSN)) {
+                    lp_result_with_new_plot_of_type[i] = 0;
+                    lp_result_with_plotsn_new_plots_of_type[i] = 0;
+                }
                 delta_profit_of_type[i]=0;
             }
         }
@@ -979,7 +1032,7 @@ RegFarmInfo::demandForLandOfType(int type,int count) {
         } else {
             if (wanted_plot_of_type[type].plot->getState()!=0) {
                 double pe_old=wanted_plot_of_type[type].pe;
-                wanted_plot_of_type[type]=farm_plot->findMostPreferablePlotOfType(type);
+                wanted_plot_of_type[type]=region->findMostPreferablePlotOfType(farm_plot,type,this);
 
                 if (wanted_plot_of_type[type].plot==NULL) {
                     adjusted_rent_offer =  unadjusted_rent_offer=        rent_offer=0;
@@ -1007,19 +1060,18 @@ RegFarmInfo::demandForLandOfType(int type,int count) {
     if (adjusted_rent_offer < 0)
         adjusted_rent_offer = 0;
 }
-double RegFarmInfo::getRentOffer(RegPlotInfo* plot) {
+double RegFarmInfo::getRentOffer(RegPlotInfo* plot, bool* recomputed) {
     int type=plot->getSoilType();
     RegPlotInformationInfo pi=farm_plot->getValue(plot,this);
-    if (wanted_plot_of_type[type].plot==NULL) {
-        lp->updatePaymentEntitlement();
-        lp_result=doLpWithPriceExpectation();
-        calculateShadowPriceForLandOfType(type,pi.pe);
-    } else {
-        if (pi.pe!=wanted_plot_of_type[type].pe) {
+    if (wanted_plot_of_type[type].plot==NULL || pi.pe!=wanted_plot_of_type[type].pe) {
+        if (!hasLandValue(type,g->PLOTSN)) {
             lp->updatePaymentEntitlement();
             lp_result=doLpWithPriceExpectation();
-            calculateShadowPriceForLandOfType(type,pi.pe);
+            resetLandValue();
         }
+        calculateShadowPriceForLandOfType(type,pi.pe);
+        if (recomputed)
+            *recomputed=true;
     }
     
     double factor = 0;
@@ -1029,6 +1081,84 @@ double RegFarmInfo::getRentOffer(RegPlotInfo* plot) {
     //return g->RENT_ADJUST_COEFFICIENT* (delta_profit_of_type[type] - pi.costs());
     return factor * (delta_profit_of_type[type] - pi.costs());
 }
+bool
+RegFarmInfo::hasLandValue(int type, int plots) const {
+    return g->LAND_VALUE_FUNCTION && !g->HAS_SOILSERVICE && land_value_plots[type]>=plots;
+}
+bool
+RegFarmInfo::hasLandValue(int plots) const {
+    for (int i=0;i<g->NO_OF_SOIL_TYPES;i++)
+        if (!hasLandValue(i,plots))
+            return false;
+    return true;
+}
+// piecewise linear through the samples at 0, 1 and PLOTSN plots, beyond
+// the last sample the last piece is extended
+double
+RegFarmInfo::landValue(int type, int plots) const {
+    double one=lp_result_with_new_plot_of_type[type];
+    if (plots<=1 || land_value_plots[type]<=1)
+        return lp_result+plots*(one-lp_result);
+    return one+(plots-1)*(lp_result_with_plotsn_new_plots_of_type[type]-one)/(double)(g->PLOTSN-1);
+}
+double
+RegFarmInfo::landValueGain(int type, int plots, double premium_entitlement) {
+    int rented=land_value_rented[type];
+    double gain=landValue(type,rented+plots)-landValue(type,rented);
+    double pe=land_value_pe[type];
+    if (premium_entitlement!=pe)
+        gain+=plots*(premium_entitlement-pe)*landValuePaymentSlope(max(premium_entitlement,pe)*g->PLOTSN);
+    return gain;
+}
+double
+RegFarmInfo::landValuePaymentSlope(double payment) {
+    if (!land_value_payment_actual) {
+        lp->setWarmStart(g->LP_WARM_START);
+        double base=lp_result;
+        // lp_result is the objective before the plots rented since
+        for (int i=0;i<g->NO_OF_SOIL_TYPES;i++)
+            if (land_value_rented[i]>0) {
+                base=doLpWithPriceExpectation();
+                break;
+            }
+        incDirectPayment(payment);
+        land_value_payment_slope=(doLpWithPriceExpectation()-base)/payment;
+        decDirectPayment(payment);
+        lp->setWarmStart(false);
+        land_value_payment_actual=true;
+    }
+    return land_value_payment_slope;
+}
+void
+RegFarmInfo::resetLandValue() {
+    for (unsigned int i=0;i<land_value_plots.size();i++) {
+        land_value_plots[i]=0;
+        land_value_rented[i]=0;
+    }
+    land_value_payment_actual=false;
+    land_value_payment_slope=0;
+}
+// The wanted plot was the cheapest free plot of the list when it was chosen.
+// A free plot of the list costs at least as much unless it was set free
+// afterwards, and with one payment entitlement for the type getRentOffer()
+// keeps the shadow price of the wanted plot.
+bool RegFarmInfo::boundRentOffer(RegPlotInfo* plot, double& bound) {
+    int type=plot->getSoilType();
+    if (!g->WEIGHTED_PLOT_SEARCH || g->SWEDEN || !actual || plot->getState()!=0)
+        return false;
+    if (free_plots_released!=region->getReleasedPlots())
+        return false;
+    if (wanted_plot_of_type[type].plot==NULL || !hasUniformPaymentEntitlement(type))
+        return false;
+
+    double factor = 0;
+    if (g->Rent_Variation) factor = rent_beta;
+    else factor = g->RENT_ADJUST_COEFFICIENT;
+    if (factor<=0)
+        return false;
+    bound = factor * (delta_profit_of_type[type] - wanted_plot_of_type[type].costs());
+    return true;
+}
 
 
 /////////////////////
@@ -1168,17 +1298,17 @@ RegFarmInfo::periodResults(int period) {
     // getolder = 1: investment object ages by 1 each year
     lt_interest_costs = FarmInvestList->getOwnBcInterest();
     if(g->LP_MOD) {
-	modulated_income_payment=getUnitsOfProduct(g->stdNameIndexs["TOTAL_PREM_MODULATED"]);
+	modulated_income_payment=getUnitsOfProduct(g->getStdNameIndex("TOTAL_PREM_MODULATED"));
     display_modulation=0;
-    if((int)(getUnitsOfProduct(g->stdNameIndexs["TRANCH_1"])+0.5)>0)
+    if((int)(getUnitsOfProduct(g->getStdNameIndex("TRANCH_1"))+0.5)>0)
       display_modulation=1;
-    if((int)(getUnitsOfProduct(g->stdNameIndexs["TRANCH_2"])+0.5)>0)
+    if((int)(getUnitsOfProduct(g->getStdNameIndex("TRANCH_2"))+0.5)>0)
       display_modulation=2;
-    if((int)(getUnitsOfProduct(g->stdNameIndexs["TRANCH_3"])+0.5)>0)
+    if((int)(getUnitsOfProduct(g->getStdNameIndex("TRANCH_3"))+0.5)>0)
       display_modulation=3;
-    if((int)(getUnitsOfProduct(g->stdNameIndexs["TRANCH_4"])+0.5)>0)
+    if((int)(getUnitsOfProduct(g->getStdNameIndex("TRANCH_4"))+0.5)>0)
       display_modulation=4;
-    if((int)(getUnitsOfProduct(g->stdNameIndexs["TRANCH_5"])+0.5)>0)
+    if((int)(getUnitsOfProduct(g->getStdNameIndex("TRANCH_5"))+0.5)>0)
       display_modulation=5;
 }
     // INCOME
@@ -1395,7 +1525,7 @@ RegFarmInfo::periodResultsForRemovedFarms() {
     // determine opp costs of labour = fix off farm labour
     oppcostslabourhour = (- FarmInvestList->getAcquisitionCostsOfNumber(g->FIXED_OFFFARM_LAB)) /
                          - FarmInvestList->getLabourSubstitutionOfNumber(g->FIXED_OFFFARM_LAB);
-    double quotarent = - milk_quota * (*product_cat)[g->stdNameIndexs["GETQUOTA"]].getPriceExpectation();
+    double quotarent = - milk_quota * (*product_cat)[g->getStdNameIndex("GETQUOTA")].getPriceExpectation();
     // farm ages one year
     farm_age++;
     interest_costs = 0;
@@ -1517,7 +1647,7 @@ void RegFarmInfo::updateYoungFarmer() {
 
 void RegFarmInfo::changeGeneration() {
 	GenChange_demograph = 1;
-	farm_age = (int)(getRandomNormalRange("DEMOGNEWAGE", g->GC_newage_normal_distr,
+	farm_age = (int)(getRandomNormalRange(RAND_GEN::DEMOGNEWAGE, g->GC_newage_normal_distr,
 		g->GC_newAge_min, g->GC_newAge_max) + 0.5);
 	g->farmAgeDists[0][farm_age]++;
 }
@@ -1542,18 +1672,18 @@ RegFarmInfo::futureOfFarm( int period) {
 
 		if (farm_age >= g->GC_age && GenChange_demograph == 0 ) {
 			if (esc >= g->ESC_exclusion) {
-				if (g->ECON_SIZE_CLASS_uni_distr(g->minstd0_ESC) < g->ESC_exclusion_prob) {
+				if (g->getRandomReal(RAND_GEN::GCESC, g->ECON_SIZE_CLASS_uni_distr, &random_streams) < g->ESC_exclusion_prob) {
 					changeGeneration();
 				}
 			}
 			else if (farm_age == g->GC_age) {
 				if (legal_type == 2) {
-					if (g->GC_CF_uni_distr(g->minstd0_cf) < g->CF_GC_prob) {
+					if (g->getRandomReal(RAND_GEN::GCCF, g->GC_CF_uni_distr, &random_streams) < g->CF_GC_prob) {
 						changeGeneration();
 					}
 				}
 				else {
-					if (g->GC_FF_uni_distr(g->minstd0_ff) < g->FF_GC_prob) {
+					if (g->getRandomReal(RAND_GEN::GCFF, g->GC_FF_uni_distr, &random_streams) < g->FF_GC_prob) {
 						changeGeneration();
 					}
 				}
@@ -1639,7 +1769,7 @@ RegFarmInfo::futureOfFarm( int period) {
 		}
 	}
     // opportunity costs for milk quota
-    quotarent = - milk_quota * (*product_cat)[g->stdNameIndexs["GETQUOTA"]].getPriceExpectation();
+    quotarent = - milk_quota * (*product_cat)[g->getStdNameIndex("GETQUOTA")].getPriceExpectation();
 
 	// change of generation every x years
     // hoc = high oppportunity costs
@@ -1647,12 +1777,11 @@ RegFarmInfo::futureOfFarm( int period) {
     
     if ((closed!=10)&& (legal_type==1) && (no_successor_by_random) && (hoc==0)) {
 		/*int border = 100;
-		int randomnumber = randlong() % border;
+		int randomnumber = g->mtrand.randlong() % border;
 		if (randomnumber <= 25)
 		*/
 		double r;
-		string name = "CLOSEFARM";
-		r = g->getRandomReal(name, g->uni_real_distrib_closeFarm);
+		r = g->getRandomReal(RAND_GEN::CLOSEFARM, g->uni_real_distrib_closeFarm, &random_streams);
 		
 		//cout << r << endl;
 		if (r<=0.25) {
@@ -2153,6 +2282,11 @@ RegFarmInfo::setRentedPlot(RegPlotInfo* p, double rent, double tacs) {
         farm_rent_exp+=rent;
         farm_tac+=tacs;
         int type=p->getSoilType();
+        // the land value function goes on from the rented plot
+        if (hasLandValue(type,1))
+            land_value_rented[type]++;
+        else
+            resetLandValue();
 		p->setRentPaid(rent);
         p->setTacs(tacs);
         p->setNewleyRented(true);
@@ -2195,7 +2329,8 @@ RegFarmInfo::updateYield() {
 // to be passed on to the LP object
 void
 RegFarmInfo::updateLpValues() {
-    if (lp->updateLpValues())g->LP_CHANGED=true;
+    resetLandValue();
+    lp->updateLpValues();
 }
 
 void
@@ -2471,13 +2606,18 @@ RegFarmInfo::getAverageNumberOfNeighbours() const {
     for (plot_iter = PlotList.begin();
             plot_iter != PlotList.end();
             ++plot_iter) {
-        countneighbours += (*plot_iter)->identifyPlotsSameStateAndFarm(farm_id);
+        countneighbours += countNeighbouringPlots(*plot_iter);
     }
     if (size>0)
         avneighbours = (double) countneighbours / (double) size;
     return avneighbours;
 }
 
+int
+RegFarmInfo::countNeighbouringPlots(RegPlotInfo* p) const {
+    return region->identifyPlotsSameStateAndFarm(p, farm_id);
+}
+
 double
 RegFarmInfo::getFarmRentExpOfType(int type) const{
     double rentexp = 0;
@@ -2566,8 +2706,8 @@ RegFarmInfo::getCapitalInputDEA() const {
     double capitalwithoutflowtingcapital = 0;
     double services = 0;
     double quota = 0;
-    services = (-1)* FarmProductList->getGrossMarginOfNumber(g->stdNameIndexs["SERVICES"])*FarmProductList->getUnitsProducedOfNumber(g->stdNameIndexs["SERVICES"]);
-    quota = (getUnitsOfProduct(g->stdNameIndexs["MILK"])*g->MILKPROD)* FarmProductList->getPriceOfNumber(g->stdNameIndexs["LETQUOTA"]);
+    services = (-1)* FarmProductList->getGrossMarginOfNumber(g->getStdNameIndex("SERVICES"))*FarmProductList->getUnitsProducedOfNumber(g->getStdNameIndex("SERVICES"));
+    quota = (getUnitsOfProduct(g->getStdNameIndex("MILK"))*g->MILKPROD)* FarmProductList->getPriceOfNumber(g->getStdNameIndex("LETQUOTA"));
     capitalwithoutflowtingcapital = services + quota + getAnnuity();
     return capitalwithoutflowtingcapital;
 }
@@ -2580,9 +2720,9 @@ RegFarmInfo::getOutputRevenue() const {
     double revgetquota = 0;
 
     prodrev = FarmProductList->getReturnOfType(g->PRODTYPE);
-    revservices = FarmProductList->getReturnOfNumber(g->stdNameIndexs["SERVICES"]);
-    revletquota = FarmProductList->getReturnOfNumber(g->stdNameIndexs["LETQUOTA"]);
-    revgetquota = FarmProductList->getReturnOfNumber(g->stdNameIndexs["GETQUOTA"]);
+    revservices = FarmProductList->getReturnOfNumber(g->getStdNameIndex("SERVICES"));
+    revletquota = FarmProductList->getReturnOfNumber(g->getStdNameIndex("LETQUOTA"));
+    revgetquota = FarmProductList->getReturnOfNumber(g->getStdNameIndex("GETQUOTA"));
 
     revDEA = prodrev - revservices - revgetquota - revletquota;
     return revDEA;
@@ -2595,9 +2735,9 @@ RegFarmInfo::getOutputGrossMarginDEA() const {
     double gmletquota = 0;
     double gmgetquota = 0;
     prodgm = FarmProductList->getGrossMarginOfType(g->PRODTYPE);
-    gmservices = FarmProductList->getGrossMarginOfNumber(g->stdNameIndexs["SERVICES"])*FarmProductList->getUnitsProducedOfNumber(g->stdNameIndexs["SERVICES"]);
-    gmletquota = FarmProductList->getGrossMarginOfNumber(g->stdNameIndexs["LETQUOTA"])*FarmProductList->getUnitsProducedOfNumber(g->stdNameIndexs["LETQUOTA"]);
-    gmgetquota = FarmProductList->getGrossMarginOfNumber(g->stdNameIndexs["GETQUOTA"])*FarmProductList->getUnitsProducedOfNumber(g->stdNameIndexs["GETQUOTA"]);
+    gmservices = FarmProductList->getGrossMarginOfNumber(g->getStdNameIndex("SERVICES"))*FarmProductList->getUnitsProducedOfNumber(g->getStdNameIndex("SERVICES"));
+    gmletquota = FarmProductList->getGrossMarginOfNumber(g->getStdNameIndex("LETQUOTA"))*FarmProductList->getUnitsProducedOfNumber(g->getStdNameIndex("LETQUOTA"));
+    gmgetquota = FarmProductList->getGrossMarginOfNumber(g->getStdNameIndex("GETQUOTA"))*FarmProductList->getUnitsProducedOfNumber(g->getStdNameIndex("GETQUOTA"));
 
     gmDEA = prodgm - gmservices - gmgetquota - gmletquota;
     return gmDEA;
@@ -2663,9 +2803,9 @@ RegFarmInfo::getEconomicLandRent()  const {
                          + st_interest_costs) /land_input;
     double ecinterest = ((equity_capital-land_assets-ecchange)*g->EQ_INTEREST)
                         /land_input;
-    double quota = ((FarmProductList->getUnitsProducedOfNumber(g->stdNameIndexs["MILK"])*g->MILKPROD
-                     + FarmProductList->getUnitsProducedOfNumber(g->stdNameIndexs["LETQUOTA"])
-                     - FarmProductList->getUnitsProducedOfNumber(g->stdNameIndexs["GETQUOTA"])
+    double quota = ((FarmProductList->getUnitsProducedOfNumber(g->getStdNameIndex("MILK"))*g->MILKPROD
+                     + FarmProductList->getUnitsProducedOfNumber(g->getStdNameIndex("LETQUOTA"))
+                     - FarmProductList->getUnitsProducedOfNumber(g->getStdNameIndex("GETQUOTA"))
                     ) * g->QUOTA_PRICE)/land_input;
 
     av_ec_land_rent =  hhincome
@@ -2799,23 +2939,15 @@ void RegFarmInfo::countContiguousPlots() {
     }
     clearTagsForContiguousPlots();
     initVectorOfContiguousPlots();
-    i=PlotList.begin();
-    int c=0;
-    do {
-        while (/*(*i)->getTag()==true && */i!=PlotList.end()) {
-            if ((*i)->getTag()==false) break;
-            c++;
-            i++;
-        }
-        if (i!=PlotList.end()) {
-            if ((*i)->getTag()==false) {
-                int nop=(*i)->countContiguousPlots(farm_id);
-                int st=(*i)->getSoilType();
-                contiguous_plots[st].push_back(nop*g->PLOT_SIZE);
-            }
+    // each contiguous plot is counted at its first plot in PlotList
+    set<int> counted;
+    for (i=PlotList.begin();i!=PlotList.end();i++) {
+        if (counted.insert(region->getContiguousPlotId(*i)).second) {
+            int nop=region->getContiguousPlotSize(*i);
+            int st=(*i)->getSoilType();
+            contiguous_plots[st].push_back(nop*g->PLOT_SIZE);
         }
-    } while (i!=PlotList.end());
-    clearTagsForContiguousPlots();
+    }
 }
 void RegFarmInfo::clearTagsForContiguousPlots() {
     list<RegPlotInfo* >::iterator plot_iter;
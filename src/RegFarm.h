@@ -35,6 +35,21 @@ class RegSectorResultsInfo;
 class RegLpInfo;
 class RegProductList;
 class RegProductInfo;
+
+/// search data a farm keeps for the plots around its farmstead
+struct RegFarmsteadSearch {
+    /// vector to store the free plots in the region
+    /// this is done on individual level because the vector is then sorted  according the value of a plot
+    vector< vector<RegPlotInformationInfo> > free_plots;
+    /// all free plots of the type have the same payment entitlement
+    vector<bool> uniform_pe;
+    /// position of a plot in free_plots of its type by plot id, -1 if not listed;
+    /// built by the first getValue() after initFreePlots()
+    vector<int> free_plot_slot;
+    /// Fast plot search: position per soil type in RegRegionInfo::rings
+    vector<int> plot_p;
+};
+
 class RegFarmInfo {
 protected:
     double rent_beta;
@@ -112,6 +127,35 @@ protected:
     vector<double> lp_result_with_new_plot_of_type;
     vector<double> delta_profit_of_type;
     vector<RegPlotInformationInfo> wanted_plot_of_type;
+    /** land value function of the renting iteration (LAND_VALUE_FUNCTION):
+        the objective lp_result and the samples lp_result_with_new_plot_of_type
+        and lp_result_with_plotsn_new_plots_of_type of a type, solved with the
+        premium entitlement land_value_pe, as a piecewise linear function of
+        the additional plots. Plots rented afterwards move along the function
+        of their type instead of solving anew; the types are taken as
+        independent. A premium entitlement other than the sampled one is
+        answered from the change of the objective per unit of direct payment,
+        solved once. Dropped by newRentingProcess() and updateLpValues().
+    */
+    vector<double> land_value_pe;
+    /// plots up to which a type is sampled: 0, 1 or PLOTSN
+    vector<int> land_value_plots;
+    /// plots of a type rented since it was sampled
+    vector<int> land_value_rented;
+    bool land_value_payment_actual;
+    double land_value_payment_slope;
+    bool hasLandValue(int type, int plots) const;
+    /// all types sampled up to plots
+    bool hasLandValue(int plots) const;
+    double landValue(int type, int plots) const;
+    /// change of the objective by plots more of type beyond those rented
+    double landValueGain(int type, int plots, double premium_entitlement);
+    double landValuePaymentSlope(double payment);
+    void resetLandValue();
+    /// released plots of the region when the free plots were listed
+    unsigned long free_plots_released;
+    /// free plots around the farmstead and the cursors of the fast plot search
+    RegFarmsteadSearch farmstead_search;
 
     // RENT
     vector<double> initial_owned_land_of_type;
@@ -147,6 +191,8 @@ protected:
     double  capital_input;
     // depreciation of asset capital
     double  sunk_costs_labor;
+    /// draws of the farm from PHILOX random streams
+    RegRandomStreams random_streams;
     double  depreciation;
     double  equity_capital;
     double  economic_profit;
@@ -320,7 +366,7 @@ public:
 	int getGenerationChange() const {
 		return GenChange_demograph;
 	}
-	double getRandomNormalRange(string, std::normal_distribution<>&, double, double);
+	double getRandomNormalRange(RAND_GEN, std::normal_distribution<>&, double, double);
 
 	//soil service
 	void initCarbons(vector<double>, vector<double>);
@@ -610,7 +656,16 @@ public:
     int getNewInvestmentExpenditure()  const{
         return FarmInvestList->getNewInvestmentExpenditure();
     }
-    double getRentOffer(RegPlotInfo*);
+    /** rent offer for plot
+        @param recomputed set to true if the shadow price of the soil type
+        was computed for plot, demandForLandOfType() then offers anew
+    */
+    double getRentOffer(RegPlotInfo* plot, bool* recomputed=NULL);
+    /** upper bound of getRentOffer(plot) when the call only reads the
+        values of the wanted plot of the type
+        @return false if getRentOffer(plot) has to be called
+    */
+    bool boundRentOffer(RegPlotInfo* plot, double& bound);
     double getRentOffer() const {
         return rent_offer;
     }
@@ -633,6 +688,10 @@ public:
     void setFarmType(int ft) {
         farm_type = ft;
     }
+    /// the farm's draws from counter-based random streams
+    RegRandomStreams* getRandomStreams() {
+        return &random_streams;
+    }
     int   getFarmId() const {
         return farm_id;
     }
@@ -820,9 +879,32 @@ public:
     int getFarmClass() const{
         return farm_class;
     }
+    /// plots of the farm with the soil type of p which are connected to p
+    int countNeighbouringPlots(RegPlotInfo* p) const;
     RegPlotInfo* getFarmPlot() {
         return farm_plot;
     }
+    RegFarmsteadSearch& getFarmsteadSearch() {
+        return farmstead_search;
+    }
+    /// FAST_PLOT_SEARCH: the cursors start at the farmstead
+    void initPlotSearch();
+    bool hasPlotPointer() const {
+        return !farmstead_search.plot_p.empty();
+    }
+    int getPlotPointer(int type) const {
+        return farmstead_search.plot_p[type];
+    }
+    void setPlotPointer(int type, int k) {
+        farmstead_search.plot_p[type]=k;
+    }
+    void resetPlotPointer();
+    /// no lists of free plots, the farm searches the region index
+    void clearFreePlots();
+    bool hasUniformPaymentEntitlement(int type) const {
+        return type<(int)farmstead_search.uniform_pe.size()
+               && farmstead_search.uniform_pe[type];
+    }
     double getEconomicProfit() const {
         return economic_profit;
     }
@@ -0,0 +1,111 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// RegFreePlotSet.cpp
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include "RegFreePlotSet.h"
+#include "RegPlot.h"
+
+RegFreePlotSet::RegFreePlotSet()
+    : count(0), used(0) {
+}
+
+void
+RegFreePlotSet::init(int plots) {
+    count = 0;
+    used = 0;
+    slot_plot.clear();
+    tree.assign(1, 0);
+    slot_of.assign(plots, -1);
+}
+
+bool
+RegFreePlotSet::contains(RegPlotInfo* p) const {
+    return slot_of[p->getId()]>=0;
+}
+
+void
+RegFreePlotSet::update(int slot, int delta) {
+    for (int i=slot+1;i<(int)tree.size();i+=i&(-i))
+        tree[i] += delta;
+}
+
+void
+RegFreePlotSet::compact(int capacity) {
+    vector<RegPlotInfo*> live;
+    for (int s=0;s<used;s++)
+        if (slot_plot[s]!=NULL)
+            live.push_back(slot_plot[s]);
+    slot_plot.assign(capacity, NULL);
+    tree.assign(capacity+1, 0);
+    used = live.size();
+    for (int s=0;s<used;s++) {
+        slot_plot[s] = live[s];
+        slot_of[live[s]->getId()] = s;
+    }
+    // linear construction of the tree
+    for (int i=1;i<=capacity;i++) {
+        if (i<=used)
+            tree[i] += 1;
+        int parent = i+(i&(-i));
+        if (parent<=capacity)
+            tree[parent] += tree[i];
+    }
+}
+
+void
+RegFreePlotSet::add(RegPlotInfo* p) {
+    if (contains(p))
+        return;
+    if (used==(int)slot_plot.size())
+        compact(max(16, 2*(count+1)));
+    slot_plot[used] = p;
+    slot_of[p->getId()] = used;
+    update(used, 1);
+    used++;
+    count++;
+}
+
+void
+RegFreePlotSet::remove(RegPlotInfo* p) {
+    int s = slot_of[p->getId()];
+    if (s<0)
+        return;
+    update(s, -1);
+    slot_plot[s] = NULL;
+    slot_of[p->getId()] = -1;
+    count--;
+}
+
+RegPlotInfo*
+RegFreePlotSet::at(int k) const {
+    // descend the tree to the slot holding the (k+1)-th plot
+    int pos = 0;
+    int step = 1;
+    while (2*step<(int)tree.size())
+        step *= 2;
+    for (;step>0;step/=2) {
+        if (pos+step<(int)tree.size() && tree[pos+step]<=k) {
+            pos += step;
+            k -= tree[pos];
+        }
+    }
+    return slot_plot[pos];
+}
+
+void
+RegFreePlotSet::remap(const vector<RegPlotInfo*>& plots) {
+    for (int s=0;s<used;s++)
+        if (slot_plot[s]!=NULL)
+            slot_plot[s] = plots[slot_plot[s]->getId()];
+}
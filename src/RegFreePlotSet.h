@@ -0,0 +1,63 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+//---------------------------------------------------------------------------
+// RegFreePlotSet.h
+//---------------------------------------------------------------------------
+#ifndef RegFreePlotSetH
+#define RegFreePlotSetH
+
+#include <vector>
+
+using namespace std;
+
+class RegPlotInfo;
+
+/** RegFreePlotSet class.
+    @short free plots of the region in the order they became free.
+    getRandomFreePlot() picks the plot at a random position of this order,
+    so the order has to be kept when plots are removed. Every plot gets
+    the next slot when it is added; a Fenwick tree over the slots counts
+    the plots still in the set, which finds the plot at a position and
+    removes a plot in O(log n). Slots of removed plots are dropped when
+    all slots are used.
+*/
+class RegFreePlotSet {
+public:
+    RegFreePlotSet();
+    /// empty set for plots with ids 0..plots-1
+    void init(int plots);
+    int size() const {
+        return count;
+    }
+    bool contains(RegPlotInfo* p) const;
+    /// p is added at the end
+    void add(RegPlotInfo* p);
+    void remove(RegPlotInfo* p);
+    /// plot at position k, 0<=k<size()
+    RegPlotInfo* at(int k) const;
+    /// replaces the plots by those of a copied region with the same ids
+    void remap(const vector<RegPlotInfo*>& plots);
+private:
+    int count;
+    /// slots used so far
+    int used;
+    vector<RegPlotInfo*> slot_plot;
+    /// slot of a plot by id, -1 if not in the set
+    vector<int> slot_of;
+    /// Fenwick tree over the slots, 1-based
+    vector<int> tree;
+    void update(int slot, int delta);
+    void compact(int capacity);
+};
+
+#endif
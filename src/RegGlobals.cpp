@@ -29,7 +29,10 @@
 #define _T(x) (x)
 
 const string RegGlobalsInfo::UsageString=
-    "USAGE: program [options] dirOfSzenarios  [ szenario [repeatNum] ] \n";
+    "USAGE: program [options] dirOfSzenarios  [ szenario [repeatNum] ] \n"
+    "  --replications a..b  runs the replications a to b in this process, each\n"
+    "                       writes to the subdirectory replication_<repeatNum>\n"
+    "  --jobs N             runs N replications at the same time\n";
 
 RegGlobalsInfo::RegGlobalsInfo() {
 	Livestock_Inv_farmsPercent = 0;
@@ -97,6 +100,9 @@ RegGlobalsInfo::RegGlobalsInfo() {
     FAST_PLOT_SEARCH=false;
     WEIGHTED_PLOT_SEARCH=true;                        //standard: true, OPR false farm areas are initialised as a circle around the farm; they search for the plot with the lowest costs, however this only matters when transaction costs are considered
     WEIGHTED_PLOT_SEARCH_VALUE=50;
+    INDEXED_PLOT_SEARCH=false;
+    ZORDER_PLOT_LAYOUT=false;
+    ZORDER_FARM_LIST=false;
     RELEASE_PLOTS_BEFORE_EXPECTATION_FORMATION=true;
     USE_VARIABLE_PRICE_CHANGE=true;
     AGE_DEPENDENT=false;//true;                          //Standard: false, CZ, Lithuania, Slovakia: true
@@ -106,6 +112,11 @@ RegGlobalsInfo::RegGlobalsInfo() {
     CALCULATE_CONTIGUOUS_PLOTS=false;
     USE_HISTORICAL_CONTIGUOUS_PLOTS=false;
     LP_MOD=true;//false;                                 //Standard: false, true is necessary for Saxony, Hohenlohe, Brittany and CZ because here we have different input files to calculate the modulation within the LP-model
+    LP_WARM_START=false;                                 //re-solve land shadow price probes from the previous basis and solution
+    LAND_VALUE_FUNCTION=false;
+    MIP_CACHE_MB=0;
+    LP_RELAXATION_FIRST=false;
+    MIP_LOG=false;
     USE_TC_FRAMEWORK=false;//true;
 
     REGION_OVERSIZE=1.15;
@@ -141,6 +152,12 @@ RegGlobalsInfo::RegGlobalsInfo() {
     PRINT_VA=false;
     PRINT_POLICY=false;
     INIT_OUTPUT=true;
+    INPUT_READ=false;
+    link_stamp=0;
+    inputs = make_shared<RegInputData>();
+    REPLICATION_FIRST=-1;
+    REPLICATION_LAST=-1;
+    JOBS=1;
 
 	tInd = 0;
 	tInd_land = 0;
@@ -177,6 +194,8 @@ CSimpleOpt::SOption g_rgOptions[] = {
 		//{ 50,  ("--REGION_OVERSIZE"),     SO_REQ_SEP },
 		//{ 60,  ("--REGION_NON_AG_LAND"),     SO_REQ_SEP },
 		{ 70,  ("--RUNS"),     SO_REQ_SEP},
+		{ 80,  ("--replications"),     SO_REQ_SEP},
+		{ 90,  ("--jobs"),     SO_REQ_SEP},
 		{ OPT_HELP, "--help", SO_NONE},
 		{ OPT_HELP, "-help", SO_NONE },
 		{ OPT_HELP, "-h", SO_NONE },
@@ -225,7 +244,7 @@ RegGlobalsInfo::readFromCommandLine() {
 
         switch (args.OptionId()) {
 		case 40:
-			options[&TEILER] = atoi(args.OptionArg());
+			options.push_back(make_pair(&RegGlobalsInfo::TEILER, atoi(args.OptionArg())));
 			//this->TEILER = atoi(args.OptionArg());
 			break;
 			/*
@@ -237,9 +256,24 @@ RegGlobalsInfo::readFromCommandLine() {
             break;
 			//*/
         case 70:
-			options[&RUNS] = atoi(args.OptionArg());
+			options.push_back(make_pair(&RegGlobalsInfo::RUNS, atoi(args.OptionArg())));
             //this->RUNS=atoi(args.OptionArg());
             break;
+        case 80: {
+            // a..b or a
+            string reps = args.OptionArg();
+            size_t pos = reps.find("..");
+            REPLICATION_FIRST = atoi(reps.substr(0, pos).c_str());
+            REPLICATION_LAST = pos==string::npos ? REPLICATION_FIRST : atoi(reps.substr(pos+2).c_str());
+            if (REPLICATION_FIRST<0 || REPLICATION_LAST<REPLICATION_FIRST) {
+                cout << "Invalid replications: " << reps << "\n";
+                exit(1);
+            }
+            break;
+        }
+        case 90:
+            JOBS = max(1, atoi(args.OptionArg()));
+            break;
               
         default:
             break;
@@ -262,7 +296,7 @@ static string Upper(string str) {
 
 void RegGlobalsInfo::initRandEngines() {
 	for (int i = 0; i < RCOUNT; ++i) {
-		RAND_ENGINES[Upper(rand_gen_names[i])] = MINSTD_RAND0;
+		rand_gens[i].engine = MINSTD_RAND0;
 	}
 }
 
@@ -279,85 +313,54 @@ RegGlobalsInfo::R_ENGINES RegGlobalsInfo::TO_RAND_ENGINE(string str) {
 			return MT19937_64;
 		else if (!str.compare("KNUTH_B"))
 			return KNUTH_B;
+		else if (!str.compare("PHILOX"))
+			return PHILOX;
 		else 
 			return MINSTD_RAND0;
 }
 
-double RegGlobalsInfo::getRandomReal(string name, uniform_real_distribution<>& distr) {
-	switch (RAND_ENGINES[name]) {
-	case 0: return distr(std::get<minstd_rand0>(RAND_GENs[name])); break;
-	case 1: return distr(std::get<minstd_rand>(RAND_GENs[name])); break;
-	case 2: return distr(std::get<mt19937>(RAND_GENs[name])); break;
-	case 3: return distr(std::get<mt19937_64>(RAND_GENs[name])); break;
-	case 4: return distr(std::get<knuth_b>(RAND_GENs[name])); break;
-	default: return distr(std::get<minstd_rand0>(RAND_GENs[name]));
-	}
-}
-
-int RegGlobalsInfo::getRandomInt(string name, uniform_int_distribution<>& distr) {
-	switch (RAND_ENGINES[name]) {
-	case 0: return distr(std::get<minstd_rand0>(RAND_GENs[name])); break;
-	case 1: return distr(std::get<minstd_rand>(RAND_GENs[name])); break;
-	case 2: return distr(std::get<mt19937>(RAND_GENs[name])); break;
-	case 3: return distr(std::get<mt19937_64>(RAND_GENs[name])); break;
-	case 4: return distr(std::get<knuth_b>(RAND_GENs[name])); break;
-	default: return distr(std::get<minstd_rand0>(RAND_GENs[name]));
-	}
-}
-
-//distr should be initialized
-double RegGlobalsInfo::getRandomNormal(string name, normal_distribution<>& distr) {
-	switch (RAND_ENGINES[name]) {
-	case 0: return distr(std::get<minstd_rand0>(RAND_GENs[name])); break;
-	case 1: return distr(std::get<minstd_rand>(RAND_GENs[name])); break;
-	case 2: return distr(std::get<mt19937>(RAND_GENs[name])); break;
-	case 3: return distr(std::get<mt19937_64>(RAND_GENs[name])); break;
-	case 4: return distr(std::get<knuth_b>(RAND_GENs[name])); break;
-	default: return distr(std::get<minstd_rand0>(RAND_GENs[name]));
-	}
-}
-
 void RegGlobalsInfo::setRandGens() {
+	const struct globdata& globdata = inputs->globdata;
 	string name0="RAND_GEN_";
 	string name;
 	string nm;
 	for (int i = 0; i < RCOUNT; ++i) {
 		nm = Upper(rand_gen_names[i]);
 		name = name0 + nm;
-		//cout <<name << ": "<< globdata.globs[name] << endl;
+		RandGenInfo& r = rand_gens[i];
+		//cout <<name << ": "<< globdata.get(name) << endl;
 		if (globdata.globs.count(name) > 0)
-			RAND_ENGINES[nm] = TO_RAND_ENGINE(globdata.globs[name]);
-		//cout << RAND_ENGINES[name] << endl;
-		int sd;
-		std::mt19937 mt;
-		std::mt19937_64 mt64;
-		std::minstd_rand0 minstd0;
-		std::minstd_rand minstd;
-		std::knuth_b knuthb;
+			r.engine = TO_RAND_ENGINE(globdata.get(name));
+		r.minstd0 = std::minstd_rand0();
+		r.minstd = std::minstd_rand();
+		r.mt = std::mt19937();
+		r.mt64 = std::mt19937_64();
+		r.knuthb = std::knuth_b();
 		if (RAND_SEEDS.count(nm) > 0) {
-			sd = RAND_SEEDS[nm];
-			mt.seed(sd);
-			mt64.seed(sd);
-			minstd0.seed(sd);
-			minstd.seed(sd);
-			knuthb.seed(sd);
+			int sd = RAND_SEEDS[nm];
+			r.mt.seed(sd);
+			r.mt64.seed(sd);
+			r.minstd0.seed(sd);
+			r.minstd.seed(sd);
+			r.knuthb.seed(sd);
 		}
-		var_RAND_GEN rand_gen;
-
-		switch (RAND_ENGINES[nm]) {
-		case MINSTD_RAND0: rand_gen = minstd0; break;
-		case MINSTD_RAND: rand_gen = minstd; break;
-		case MT19937: rand_gen = mt; break;
-		case MT19937_64: rand_gen = mt64; break;
-		case KNUTH_B: rand_gen = knuthb; break;
-		default: rand_gen = minstd0;
-		}
-		
-		RAND_GENs[nm]=rand_gen;
+		// without a seed of its own a PHILOX stream depends on the repetition
+		r.philox_seed = RAND_SEEDS.count(nm) > 0 ? RAND_SEEDS[nm] : SEED;
+		r.philox_stream = RegPhilox::streamKey(nm);
   }
 }
 
+// the data is not changed after it is read, the clones of the globals
+// share it without locks
+void RegGlobalsInfo::readInputs() {
+	shared_ptr<RegInputData> data = make_shared<RegInputData>();
+	data->readfiles(this);
+	inputs = data;
+	INPUT_READ = true;
+}
+
 void RegGlobalsInfo::setSeeds() {
+	const struct globdata& globdata = inputs->globdata;
 	string name0 = "SEED_";
 	string name;
 	string nm;
@@ -365,142 +368,145 @@ void RegGlobalsInfo::setSeeds() {
 		nm = Upper(rand_gen_names[i]);
 		name = name0 + nm;
 		if (globdata.globs.count(name) > 0)
-			RAND_SEEDS[nm] = atoi(globdata.globs[name].c_str());
+			RAND_SEEDS[nm] = atoi(globdata.get(name).c_str());
 	}
 }
 
 void RegGlobalsInfo::initYoungFarmer() {
-	YF_startpayMaxAge = atof(globdata.globs["YF_STARTPAYMAXAGE"].c_str());
-	YF_priceHa = - atof(globdata.globs["YF_PRICEHA"].c_str());
-	YF_maxHa = atof(globdata.globs["YF_MAXHA"].c_str());
+	const struct globdata& globdata = inputs->globdata;
+	YF_startpayMaxAge = atof(globdata.get("YF_STARTPAYMAXAGE").c_str());
+	YF_priceHa = - atof(globdata.get("YF_PRICEHA").c_str());
+	YF_maxHa = atof(globdata.get("YF_MAXHA").c_str());
 	YF_maxPay = YF_maxHa * YF_priceHa;
-	YF_minHa = atof(globdata.globs["YF_MINHA"].c_str());
-	YF_payYears = atoi(globdata.globs["YF_PAYYEARS"].c_str());
+	YF_minHa = atof(globdata.get("YF_MINHA").c_str());
+	YF_payYears = atoi(globdata.get("YF_PAYYEARS").c_str());
 }
 
 void RegGlobalsInfo::initDemograph() {
-	FF_initAge_mean = atof(globdata.globs["FF_INITAGE_MEAN"].c_str());
-	FF_initAge_dev= atof(globdata.globs["FF_INITAGE_DEV"].c_str());
-	CF_initAge_mean = atof(globdata.globs["CF_INITAGE_MEAN"].c_str());
-	CF_initAge_dev = atof(globdata.globs["CF_INITAGE_DEV"].c_str());
-	FF_InitAge_min = atoi(globdata.globs["FF_INITAGE_MIN"].c_str());
-	FF_InitAge_max = atoi(globdata.globs["FF_INITAGE_MAX"].c_str());
-	CF_InitAge_min = atoi(globdata.globs["CF_INITAGE_MIN"].c_str());
-	CF_InitAge_max = atoi(globdata.globs["CF_INITAGE_MAX"].c_str());
-	GC_age= atoi(globdata.globs["GC_AGE"].c_str());
-	GC_age_max = atoi(globdata.globs["GC_AGE_MAX"].c_str());
-	GC_newAge_min = atoi(globdata.globs["GC_NEWAGE_MIN"].c_str());
-	GC_newAge_max = atoi(globdata.globs["GC_NEWAGE_MAX"].c_str());
-	GC_newAge_mean = atof(globdata.globs["GC_NEWAGE_MEAN"].c_str());
-	GC_newAge_dev = atof(globdata.globs["GC_NEWAGE_DEV"].c_str());
-	FF_GC_prob = atof(globdata.globs["FF_GC_PROB"].c_str());
-	CF_GC_prob = atof(globdata.globs["CF_GC_PROB"].c_str());
-	FF_prod_decrease = atof(globdata.globs["FF_PROD_DECREASE"].c_str());
+	const struct globdata& globdata = inputs->globdata;
+	FF_initAge_mean = atof(globdata.get("FF_INITAGE_MEAN").c_str());
+	FF_initAge_dev= atof(globdata.get("FF_INITAGE_DEV").c_str());
+	CF_initAge_mean = atof(globdata.get("CF_INITAGE_MEAN").c_str());
+	CF_initAge_dev = atof(globdata.get("CF_INITAGE_DEV").c_str());
+	FF_InitAge_min = atoi(globdata.get("FF_INITAGE_MIN").c_str());
+	FF_InitAge_max = atoi(globdata.get("FF_INITAGE_MAX").c_str());
+	CF_InitAge_min = atoi(globdata.get("CF_INITAGE_MIN").c_str());
+	CF_InitAge_max = atoi(globdata.get("CF_INITAGE_MAX").c_str());
+	GC_age= atoi(globdata.get("GC_AGE").c_str());
+	GC_age_max = atoi(globdata.get("GC_AGE_MAX").c_str());
+	GC_newAge_min = atoi(globdata.get("GC_NEWAGE_MIN").c_str());
+	GC_newAge_max = atoi(globdata.get("GC_NEWAGE_MAX").c_str());
+	GC_newAge_mean = atof(globdata.get("GC_NEWAGE_MEAN").c_str());
+	GC_newAge_dev = atof(globdata.get("GC_NEWAGE_DEV").c_str());
+	FF_GC_prob = atof(globdata.get("FF_GC_PROB").c_str());
+	CF_GC_prob = atof(globdata.get("CF_GC_PROB").c_str());
+	FF_prod_decrease = atof(globdata.get("FF_PROD_DECREASE").c_str());
 
 	if (globdata.globs.count("ESC_EXCLUSION"))
-	   ESC_exclusion = atoi(globdata.globs["ESC_EXCLUSION"].c_str());
+	   ESC_exclusion = atoi(globdata.get("ESC_EXCLUSION").c_str());
 	else ESC_exclusion = 7; // ESC maximal 6
 	if (globdata.globs.count("ESC_EXCLUSION_PROB"))
-		ESC_exclusion_prob = atof(globdata.globs["ESC_EXCLUSION_PROB"].c_str());
+		ESC_exclusion_prob = atof(globdata.get("ESC_EXCLUSION_PROB").c_str());
 	else ESC_exclusion_prob = 1;
 }
 
 void
 RegGlobalsInfo::initGlobalsRead() {
-	//RestrictInvestments = globdata.globs["RESTRICTINVESTMENTS"].compare("true") == 0 ? true : false;
-	Livestock_Inv_farmsPercent = atof(globdata.globs["LIVESTOCK_INV_FARMSPERCENT"].c_str());
+	const struct globdata& globdata = inputs->globdata;
+	//RestrictInvestments = globdata.get("RESTRICTINVESTMENTS").compare("true") == 0 ? true : false;
+	Livestock_Inv_farmsPercent = atof(globdata.get("LIVESTOCK_INV_FARMSPERCENT").c_str());
 	
-	//TEILER = atoi(globdata.globs["TEILER"].c_str());
-
-	MIN_CONTRACT_LENGTH = atoi(globdata.globs["MIN_CONTRACT_LENGTH"].c_str());
-	MAX_CONTRACT_LENGTH = atoi(globdata.globs["MAX_CONTRACT_LENGTH"].c_str());
-	WITHDRAWFACTOR = atof(globdata.globs["WITHDRAWFACTOR"].c_str());
-
-	REGION_OVERSIZE = atof(globdata.globs["OVERSIZE"].c_str());
-	REGION_NON_AG_LAND = atof(globdata.globs["NON_AG_LAND"].c_str());
-
-	PLOTSN = atoi(globdata.globs["PLOTSN"].c_str());
-	PIGLETS_PER_SOW = atof(globdata.globs["PIGLETS_PER_SOW"].c_str());
-	PIGS_PER_PLACE = atof(globdata.globs["PIGS_PER_PLACE"].c_str());
-	MILKPROD = atof(globdata.globs["MILKPROD"].c_str());
-	ESU = atof(globdata.globs["ESU"].c_str());
-
-	BONUS = atof(globdata.globs["BONUS"].c_str());
-	REFINCOME = atof(globdata.globs["REFINCOME"].c_str());
-	//PRODUCTGROUPS = atoi(globdata.globs["PRODUCTGROUPS"].c_str());
-	//PRODGROUPLAB = atoi(globdata.globs["PRODGROUPLAB"].c_str());
-	//PRODTYPE = atoi(globdata.globs["PRODTYPE"].c_str());
-
-	CHANGEPERHA = atof(globdata.globs["CHANGEPERHA"].c_str());
-	CHANGEUP = atof(globdata.globs["CHANGEUP"].c_str());
-	CHANGEDOWN = atof(globdata.globs["CHANGEDOWN"].c_str());
-
-	MILKUPPERLIMIT = atof(globdata.globs["MILKUPPERLIMIT"].c_str());
-	MILKLOWERLIMIT = atof(globdata.globs["MILKLOWERLIMIT"].c_str());
-
-	//OFFFARMLABTYPE = atoi(globdata.globs["OFFFARMLABTYPE"].c_str());
-	//VAROFFARMLABTYPE = atoi(globdata.globs["VAROFFFARMLABTYPE"].c_str());
-	//VARHIREDLABTYPE = atoi(globdata.globs["VARHIREDLABTYPE"].c_str());
-	//ST_BOR_INTERESTTYPE = atoi(globdata.globs["ST_BOR_INTERESTTYPE"].c_str());
-	//ST_EC_INTERESTTYPE = atoi(globdata.globs["ST_EC_INTERESTTYPE"].c_str());
-
-	PLOT_SIZE = atof(globdata.globs["PLOTSIZE"].c_str());
-	MAX_H_LU = atoi(globdata.globs["LABOUR_HOURS_PER_UNIT"].c_str());
-	INTEREST_RATE = atof(globdata.globs["INTEREST"].c_str());
-	REGION_MILK_QUOTA = atof(globdata.globs["REGIONAL_MILK_QUOTA"].c_str());
-	OVERHEADS = atof(globdata.globs["OVERHEADS"].c_str());
-	LOWER_BORDER = atof(globdata.globs["LOWER_BORDER"].c_str());
-	UPPER_BORDER = atof(globdata.globs["UPPER_BORDER"].c_str());
-
-	ManagerMean = atof(globdata.globs["MANAGERMEAN"].c_str());
-	ManagerDev= atof(globdata.globs["MANAGERDEV"].c_str());
+	//TEILER = atoi(globdata.get("TEILER").c_str());
+
+	MIN_CONTRACT_LENGTH = atoi(globdata.get("MIN_CONTRACT_LENGTH").c_str());
+	MAX_CONTRACT_LENGTH = atoi(globdata.get("MAX_CONTRACT_LENGTH").c_str());
+	WITHDRAWFACTOR = atof(globdata.get("WITHDRAWFACTOR").c_str());
+
+	REGION_OVERSIZE = atof(globdata.get("OVERSIZE").c_str());
+	REGION_NON_AG_LAND = atof(globdata.get("NON_AG_LAND").c_str());
+
+	PLOTSN = atoi(globdata.get("PLOTSN").c_str());
+	PIGLETS_PER_SOW = atof(globdata.get("PIGLETS_PER_SOW").c_str());
+	PIGS_PER_PLACE = atof(globdata.get("PIGS_PER_PLACE").c_str());
+	MILKPROD = atof(globdata.get("MILKPROD").c_str());
+	ESU = atof(globdata.get("ESU").c_str());
+
+	BONUS = atof(globdata.get("BONUS").c_str());
+	REFINCOME = atof(globdata.get("REFINCOME").c_str());
+	//PRODUCTGROUPS = atoi(globdata.get("PRODUCTGROUPS").c_str());
+	//PRODGROUPLAB = atoi(globdata.get("PRODGROUPLAB").c_str());
+	//PRODTYPE = atoi(globdata.get("PRODTYPE").c_str());
+
+	CHANGEPERHA = atof(globdata.get("CHANGEPERHA").c_str());
+	CHANGEUP = atof(globdata.get("CHANGEUP").c_str());
+	CHANGEDOWN = atof(globdata.get("CHANGEDOWN").c_str());
+
+	MILKUPPERLIMIT = atof(globdata.get("MILKUPPERLIMIT").c_str());
+	MILKLOWERLIMIT = atof(globdata.get("MILKLOWERLIMIT").c_str());
+
+	//OFFFARMLABTYPE = atoi(globdata.get("OFFFARMLABTYPE").c_str());
+	//VAROFFARMLABTYPE = atoi(globdata.get("VAROFFFARMLABTYPE").c_str());
+	//VARHIREDLABTYPE = atoi(globdata.get("VARHIREDLABTYPE").c_str());
+	//ST_BOR_INTERESTTYPE = atoi(globdata.get("ST_BOR_INTERESTTYPE").c_str());
+	//ST_EC_INTERESTTYPE = atoi(globdata.get("ST_EC_INTERESTTYPE").c_str());
+
+	PLOT_SIZE = atof(globdata.get("PLOTSIZE").c_str());
+	MAX_H_LU = atoi(globdata.get("LABOUR_HOURS_PER_UNIT").c_str());
+	INTEREST_RATE = atof(globdata.get("INTEREST").c_str());
+	REGION_MILK_QUOTA = atof(globdata.get("REGIONAL_MILK_QUOTA").c_str());
+	OVERHEADS = atof(globdata.get("OVERHEADS").c_str());
+	LOWER_BORDER = atof(globdata.get("LOWER_BORDER").c_str());
+	UPPER_BORDER = atof(globdata.get("UPPER_BORDER").c_str());
+
+	ManagerMean = atof(globdata.get("MANAGERMEAN").c_str());
+	ManagerDev= atof(globdata.get("MANAGERDEV").c_str());
 	
-	SHARE_SELF_FINANCE = atof(globdata.globs["SELF_FINANCE_SHARE"].c_str());
-	TRANSPORT_COSTS = atoi(globdata.globs["TRANSPORT_COSTS"].c_str());
-	WD_FACTOR = atoi(globdata.globs["CAPITAL_WITHDRAW_FACTOR"].c_str());
-	GENERATION_CHANGE = atoi(globdata.globs["GENERATION_CHANGE"].c_str());
-	INVEST_GROUPS = atoi(globdata.globs["INVEST_GROUPS"].c_str());
-	RENT_ADJUST_COEFFICIENT_N = atoi(globdata.globs["RENT_ADJUST_NEIGHBOURS"].c_str());
-	RENT_ADJUST_COEFFICIENT = atof(globdata.globs["RENT_ADJUST_FACTOR"].c_str());
-	TC_MACHINERY = atoi(globdata.globs["TC_MACHINERY"].c_str());
-	SIM_VERSION = atoi(globdata.globs["SIMVERSION"].c_str());
+	SHARE_SELF_FINANCE = atof(globdata.get("SELF_FINANCE_SHARE").c_str());
+	TRANSPORT_COSTS = atoi(globdata.get("TRANSPORT_COSTS").c_str());
+	WD_FACTOR = atoi(globdata.get("CAPITAL_WITHDRAW_FACTOR").c_str());
+	GENERATION_CHANGE = atoi(globdata.get("GENERATION_CHANGE").c_str());
+	INVEST_GROUPS = atoi(globdata.get("INVEST_GROUPS").c_str());
+	RENT_ADJUST_COEFFICIENT_N = atoi(globdata.get("RENT_ADJUST_NEIGHBOURS").c_str());
+	RENT_ADJUST_COEFFICIENT = atof(globdata.get("RENT_ADJUST_FACTOR").c_str());
+	TC_MACHINERY = atoi(globdata.get("TC_MACHINERY").c_str());
+	SIM_VERSION = atoi(globdata.get("SIMVERSION").c_str());
 
 	if (LP_MOD) {
-		TRANCH_1_WIDTH = atof(globdata.globs["TRANCH_1_WIDTH"].c_str());
-		TRANCH_2_WIDTH = atof(globdata.globs["TRANCH_2_WIDTH"].c_str());
-		TRANCH_3_WIDTH = atof(globdata.globs["TRANCH_3_WIDTH"].c_str());
-		TRANCH_4_WIDTH = atof(globdata.globs["TRANCH_4_WIDTH"].c_str());
-		TRANCH_5_WIDTH = atof(globdata.globs["TRANCH_5_WIDTH"].c_str());
+		TRANCH_1_WIDTH = atof(globdata.get("TRANCH_1_WIDTH").c_str());
+		TRANCH_2_WIDTH = atof(globdata.get("TRANCH_2_WIDTH").c_str());
+		TRANCH_3_WIDTH = atof(globdata.get("TRANCH_3_WIDTH").c_str());
+		TRANCH_4_WIDTH = atof(globdata.get("TRANCH_4_WIDTH").c_str());
+		TRANCH_5_WIDTH = atof(globdata.get("TRANCH_5_WIDTH").c_str());
 	}
 	else {
-		LB_LOW_TRANCH = atof(globdata.globs["LOWER_BOUND_LOW_TRANCH"].c_str());
-		UB_LOW_TRANCH = atof(globdata.globs["UPPER_BOUND_LOW_TRANCH"].c_str());
-		LB_MIDDLE_TRANCH = atof(globdata.globs["LOWER_BOUND_MIDDLE_TRANCH"].c_str());
-		UB_MIDDLE_TRANCH = atof(globdata.globs["UPPER_BOUND_MIDDLE_TRANCH"].c_str());
-		LB_HIGH_TRANCH = atof(globdata.globs["LOWER_BOUND_HIGH_TRANCH"].c_str());
-		UB_HIGH_TRANCH = atof(globdata.globs["UPPER_BOUND_HIGH_TRANCH"].c_str());
+		LB_LOW_TRANCH = atof(globdata.get("LOWER_BOUND_LOW_TRANCH").c_str());
+		UB_LOW_TRANCH = atof(globdata.get("UPPER_BOUND_LOW_TRANCH").c_str());
+		LB_MIDDLE_TRANCH = atof(globdata.get("LOWER_BOUND_MIDDLE_TRANCH").c_str());
+		UB_MIDDLE_TRANCH = atof(globdata.get("UPPER_BOUND_MIDDLE_TRANCH").c_str());
+		LB_HIGH_TRANCH = atof(globdata.get("LOWER_BOUND_HIGH_TRANCH").c_str());
+		UB_HIGH_TRANCH = atof(globdata.get("UPPER_BOUND_HIGH_TRANCH").c_str());
 	}
 
-	FIX_REFERENCE_PERIOD = atoi(globdata.globs["FIX_REFERENCE_PERIOD"].c_str());
+	FIX_REFERENCE_PERIOD = atoi(globdata.get("FIX_REFERENCE_PERIOD").c_str());
 	if (USE_TC_FRAMEWORK) {
-		LEGAL_TYPE_BONUS = atoi(globdata.globs["LEGAL_TYPE_BONUS"].c_str()) ? true : false;
-		PREV_OWNER_BONUS = atoi(globdata.globs["PREV_OWNER_BONUS"].c_str()) ? true : false;
-		FIXED_BONUS = atoi(globdata.globs["FIXED_BONUS"].c_str()) ? true : false;
+		LEGAL_TYPE_BONUS = atoi(globdata.get("LEGAL_TYPE_BONUS").c_str()) ? true : false;
+		PREV_OWNER_BONUS = atoi(globdata.get("PREV_OWNER_BONUS").c_str()) ? true : false;
+		FIXED_BONUS = atoi(globdata.get("FIXED_BONUS").c_str()) ? true : false;
 		if (FIXED_BONUS)
-			FIXED_BONUS_VALUE = atoi(globdata.globs["FIXED_BONUS_VALUE"].c_str());
-		VARIABLE_BONUS = atoi(globdata.globs["VARIABLE_BONUS"].c_str()) ? true : false;
+			FIXED_BONUS_VALUE = atoi(globdata.get("FIXED_BONUS_VALUE").c_str());
+		VARIABLE_BONUS = atoi(globdata.get("VARIABLE_BONUS").c_str()) ? true : false;
 		if (VARIABLE_BONUS)
-			VARIABLE_BONUS_VALUE = atoi(globdata.globs["VARIABLE_BONUS_VALUE"].c_str());
-		MIN_CONTRACT_LENGTH = atoi(globdata.globs["MIN_CONTRACT_LENGTH"].c_str());
-		MAX_CONTRACT_LENGTH = atoi(globdata.globs["MAX_CONTRACT_LENGTH"].c_str());
+			VARIABLE_BONUS_VALUE = atoi(globdata.get("VARIABLE_BONUS_VALUE").c_str());
+		MIN_CONTRACT_LENGTH = atoi(globdata.get("MIN_CONTRACT_LENGTH").c_str());
+		MAX_CONTRACT_LENGTH = atoi(globdata.get("MAX_CONTRACT_LENGTH").c_str());
 	}
-	NO_OF_SOIL_TYPES = atoi(globdata.globs["NUMBER_OF_SOIL_TYPES"].c_str());
+	NO_OF_SOIL_TYPES = atoi(globdata.get("NUMBER_OF_SOIL_TYPES").c_str());
 
 	//NASG 2019
-	NASG_startPeriod= atoi(globdata.globs["NASG_START_PERIOD"].c_str());
-	NASG_maxRentAv = atof(globdata.globs["NASG_MAXRENTAV"].c_str());
-	NASG_maxShareUAA = atof(globdata.globs["NASG_MAXSHAREUAA"].c_str());
-	NASG_maxSizeFactor = atof(globdata.globs["NASG_MAXSIZEFACTOR"].c_str());
+	NASG_startPeriod= atoi(globdata.get("NASG_START_PERIOD").c_str());
+	NASG_maxRentAv = atof(globdata.get("NASG_MAXRENTAV").c_str());
+	NASG_maxShareUAA = atof(globdata.get("NASG_MAXSHAREUAA").c_str());
+	NASG_maxSizeFactor = atof(globdata.get("NASG_MAXSIZEFACTOR").c_str());
     
 	setSeeds();
 	setRandGens();
@@ -513,6 +519,8 @@ RegGlobalsInfo::initGlobalsRead() {
 
 void
 RegGlobalsInfo::initGlobals() {
+const struct farmsdata& farmsdata = inputs->farmsdata;
+const struct globdata& globdata = inputs->globdata;
 tIter=-1;
 tFarmId=-1;
 tFarmName="---";
@@ -568,9 +576,9 @@ if (ManagerDemographics || YoungFarmer) {
 
     for (int i=0;i<noft;i++) {
         for (int k=0;k<NO_OF_SOIL_TYPES;k++) {
-            LAND_INPUT_OF_TYPE[k] +=(farmsdata.alllands[globdata.namesOfSoilTypes[k]].owned_land[i])
+            LAND_INPUT_OF_TYPE[k] +=(farmsdata.alllands.at(globdata.namesOfSoilTypes[k]).owned_land[i])
                             *number_of_each_type[i];
-            LAND_INPUT_OF_TYPE[k] += (farmsdata.alllands[globdata.namesOfSoilTypes[k]].rented_land[i])
+            LAND_INPUT_OF_TYPE[k] += (farmsdata.alllands.at(globdata.namesOfSoilTypes[k]).rented_land[i])
                             *number_of_each_type[i];
          }
     }
@@ -598,18 +606,16 @@ if (ManagerDemographics || YoungFarmer) {
 }    // annuityFactor
 
 
-double RegGlobalsInfo::triangular(string whichgen, double min, double ml, double max) {
+double RegGlobalsInfo::triangular(RAND_GEN whichgen, double min, double ml, double max, RegRandomStreams* streams) {
     double r;
-	//string name = "MGMTCOEFF";
-	var_RAND_GEN& rgen = RAND_GENs[whichgen];
-	if (!whichgen.compare("MGMTCOEFF")) {
-		r = getRandomReal(whichgen, uni_real_distrib_mgmtCoeff);
+	if (whichgen == RAND_GEN::MGMTCOEFF) {
+		r = getRandomReal(whichgen, uni_real_distrib_mgmtCoeff, streams);
 	}
-	else if (!whichgen.compare("FARMAGE")) {
-		r = getRandomInt(whichgen, uni_int_distrib_farmAge);
+	else if (whichgen == RAND_GEN::FARMAGE) {
+		r = getRandomInt(whichgen, uni_int_distrib_farmAge, streams);
 	}
-	else if (!whichgen.compare("RENTVARIATION")) {
-		r = getRandomReal(whichgen, uni_real_distrib_rentVar);
+	else if (whichgen == RAND_GEN::RENTVARIATION) {
+		r = getRandomReal(whichgen, uni_real_distrib_rentVar, streams);
 	}
 
 	//cout << "triang: " << r << endl;
@@ -640,6 +646,18 @@ double averageReturn(double p, int t) {
     return ar;
 }
 
+string phaseName(SimPhase p) {
+    switch (p) {
+    case SimPhase::INIT: return "init";
+    case SimPhase::LAND: return "land";
+    case SimPhase::INVEST: return "invest";
+    case SimPhase::PRODUCT: return "product";
+    case SimPhase::FUTURE: return "future";
+    case SimPhase::BETWEEN: return "between";
+    default: return "all";
+    }
+}
+
 void
 RegGlobalsInfo::backup() {
     obj_backup=clone();
@@ -647,8 +665,10 @@ RegGlobalsInfo::backup() {
 void
 RegGlobalsInfo::restore() {
     RegGlobalsInfo* tmp=obj_backup;
+    unsigned long stamp=link_stamp;
     *this=*obj_backup;
     obj_backup=tmp;
+    link_stamp=stamp;
 }
 RegGlobalsInfo* RegGlobalsInfo::clone() {
     return new RegGlobalsInfo(*this);
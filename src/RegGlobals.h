@@ -22,13 +22,31 @@
 #include <map>
 #include <string>
 #include <random>
-#include <variant>
+#include <memory>
+#include "RegMipCache.h"
+#include "RegMipLog.h"
+#include "RegRandom.h"
+#include "random.h"
 
 enum class SimPhase { INIT, LAND, INVEST, PRODUCT, FUTURE, BETWEEN,ALL };
+string phaseName(SimPhase);
 enum class DISTRIB_TYPE {UNIFORM, NORMAL};
+/// random number generators, in the order of RegGlobalsInfo::rand_gen_names
+enum class RAND_GEN { MGMTCOEFF, FARMAGE, CLOSEFARM, INVESTAGE,
+	CONTRACTLENGTHINIT, CONTRACTLENGTH,
+	FREEPLOT_RENTPLOT, FREEPLOT_INITLAND,
+	DEMOGFF, DEMOGCF, DEMOGNEWAGE, LIVESTOCK_INV, RENTVARIATION,
+	GCESC, GCCF, GCFF };
 
 //static int rndcounter=0;
 using namespace std;
+struct RegInputData;
+/** RegGlobalsInfo class.
+    @short options and state of one simulation. Replications running at
+    once (JOBS) have a copy each and share only the input data, which is
+    not changed, and the MIP cache. GLPK stays process global, its calls
+    are serialized by glpk_mutex in RegLpD.cpp.
+*/
 class RegGlobalsInfo {
 public:
     //rent-variation
@@ -70,13 +88,11 @@ public:
 
 	//Economicsize exception by GC
 	std::uniform_real_distribution<> ECON_SIZE_CLASS_uni_distr;
-	std::minstd_rand0 minstd0_ESC;
     int	ESC_exclusion;
 	double ESC_exclusion_prob;
 
 	std::normal_distribution<> FF_age_normal_distr, CF_age_normal_distr,GC_newage_normal_distr;
 	std::uniform_real_distribution<> GC_FF_uni_distr, GC_CF_uni_distr;
-	std::minstd_rand0 minstd0_cf, minstd0_ff;
 	
 	vector<map<int, int>> farmAgeDists;
 		
@@ -98,24 +114,65 @@ public:
 	vector<double> MaxRents;
 	bool SDEBUG1, SDEBUG2;
 
-	static const size_t RCOUNT = 13; //# of extra random number generators
+	static const size_t RCOUNT = 16; //# of extra random number generators
 	string rand_gen_names[RCOUNT] = { "mgmtCoeff","farmAge","closeFarm", "investAge",
 		"contractLengthInit","contractLength",
 		"freePlot_rentPlot", "freePlot_initLand",
-		"demogFF", "demogCF", "demogNewage", "livestock_inv", "rentVariation"};// , "randPlotType_preparePeriod"
-
-
-	enum R_ENGINES { MINSTD_RAND0, MINSTD_RAND, MT19937, MT19937_64, KNUTH_B };
+		"demogFF", "demogCF", "demogNewage", "livestock_inv", "rentVariation",
+		"gcESC", "gcCF", "gcFF"};// , "randPlotType_preparePeriod"
+
+
+	/// PHILOX: counter-based, see RegPhilox
+	enum R_ENGINES { MINSTD_RAND0, MINSTD_RAND, MT19937, MT19937_64, KNUTH_B, PHILOX };
+
+	/** engine of a random number generator, set up in initRandEngines()
+	    and setRandGens(). Only the engine of type engine is used.
+	*/
+	struct RandGenInfo {
+		R_ENGINES engine;
+		std::minstd_rand0 minstd0;
+		std::minstd_rand minstd;
+		std::mt19937 mt;
+		std::mt19937_64 mt64;
+		std::knuth_b knuthb;
+		/// seed and key word of the name of a PHILOX stream
+		uint32_t philox_seed;
+		uint32_t philox_stream;
+	};
+	RandGenInfo rand_gens[RCOUNT];
 	
 	map <string,int> RAND_SEEDS;
 	void setSeeds();
-	map<string,R_ENGINES> RAND_ENGINES;
 	void initRandEngines();
 	void setRandGens();
 	R_ENGINES TO_RAND_ENGINE(string);
+	/// draws from PHILOX streams not made for a farm
+	RegRandomStreams random_streams;
+	/// Mersenne Twister of randlong() and rand_normal()
+	RandMT mtrand;
 	
-	int getRandomInt(string, std::uniform_int_distribution<>&);
-	double getRandomReal(string, std::uniform_real_distribution<>&);
+	/** draws from the generator id. For a PHILOX stream the draw is given
+	    by the farm of streams (NULL: random_streams), the iteration and
+	    the number of draws of the farm so far in the iteration.
+	*/
+	template <class D> typename D::result_type
+	getRandom(RAND_GEN id, D& distr, RegRandomStreams* streams=NULL) {
+		RandGenInfo& r = rand_gens[(int)id];
+		switch (r.engine) {
+		case MINSTD_RAND: return distr(r.minstd);
+		case MT19937: return distr(r.mt);
+		case MT19937_64: return distr(r.mt64);
+		case KNUTH_B: return distr(r.knuthb);
+		case PHILOX: return getPhiloxRandom(id, distr, streams);
+		default: return distr(r.minstd0);
+		}
+	}
+	int getRandomInt(RAND_GEN id, std::uniform_int_distribution<>& distr, RegRandomStreams* streams=NULL) {
+		return getRandom(id, distr, streams);
+	}
+	double getRandomReal(RAND_GEN id, std::uniform_real_distribution<>& distr, RegRandomStreams* streams=NULL) {
+		return getRandom(id, distr, streams);
+	}
 
     std::uniform_real_distribution<> uni_real_distrib_rentVar;
 	std::uniform_real_distribution<> uni_real_distrib_mgmtCoeff;
@@ -133,12 +190,21 @@ public:
 	double ManagerMean;
 	double ManagerDev;
 	std::normal_distribution<> normal_distr;
-	double getRandomNormal(string, std::normal_distribution<>&);
+	double getRandomNormal(RAND_GEN id, std::normal_distribution<>& distr, RegRandomStreams* streams=NULL) {
+		return getRandom(id, distr, streams);
+	}
+	/// a distribution like distr on the engine of the next draw of the PHILOX stream id
+	template <class D> typename D::result_type
+	getPhiloxRandom(RAND_GEN id, const D& distr, RegRandomStreams* streams) {
+		RegRandomStreams& s = streams ? *streams : random_streams;
+		const RandGenInfo& r = rand_gens[(int)id];
+		RegPhilox engine(r.philox_seed, r.philox_stream, s.getFarm(), tIter, s.next((int)id, tIter));
+		// a copy, distributions such as the normal one keep numbers for the next call
+		D d(distr.param());
+		return d(engine);
+	}
 
-	using var_RAND_GEN = variant<std::mt19937, std::mt19937_64,
-		std::minstd_rand, std::minstd_rand0, std::knuth_b>;
-	map<string, var_RAND_GEN> RAND_GENs;
-	double triangular(string, double, double, double);
+	double triangular(RAND_GEN, double, double, double, RegRandomStreams* streams=NULL);
 
 	static const string UsageString;
 
@@ -172,7 +238,6 @@ public:
     double WERTS2;
     virtual RegGlobalsInfo* create();
     virtual RegGlobalsInfo* clone();
-    bool LP_CHANGED;
     bool INITIALISATION;
     virtual void backup();
     virtual void restore();
@@ -194,6 +259,12 @@ public:
     bool SOIL_TYPE_VARIATION;
     bool WEIGHTED_PLOT_SEARCH;
     double WEIGHTED_PLOT_SEARCH_VALUE;
+    /// farms search the free plots in the region index instead of own sorted lists
+    bool INDEXED_PLOT_SEARCH;
+    /// the plot store is laid out along the Z-order curve through the region
+    bool ZORDER_PLOT_LAYOUT;
+    /// farms are ordered in the FarmList along the Z-order curve by their farmstead
+    bool ZORDER_FARM_LIST;
     bool FIX_PRICES;
     bool MIN_WITHDRAWAL;
     bool USE_TRIANGULAR_DISTRIBUTED_MANAGEMENT_FACTOR;
@@ -206,8 +277,28 @@ public:
     bool SET_FREE_PLOTS;
     vector<int> FREE_PLOTS_OF_TYPE;
     bool LP_MOD;
+    bool LP_WARM_START;
+    /// answer the rent offers of a renting round from the land value function of the farm
+    bool LAND_VALUE_FUNCTION;
+    /// skip branch and bound if the LP relaxation is integral
+    bool LP_RELAXATION_FIRST;
+    /// memory cap of the MIP result cache in MB, 0: no cache
+    int MIP_CACHE_MB;
+    /// created before the simulations if MIP_CACHE_MB>0, copies of g share it
+    shared_ptr<RegMipCache> mipcache;
+    /// log every farm MIP solve, see RegMipLog
+    bool MIP_LOG;
+    shared_ptr<RegMipLog> miplog;
 	
     string INPUTFILEdir; 
+    /// directory of the options and scenario files, with a trailing /
+    string OPTIONFILEdir;
+    /// the input files were read before, once for all replications of the process
+    bool INPUT_READ;
+    /// data of the input files, shared by the clones of the globals
+    shared_ptr<const RegInputData> inputs;
+    /// reads the input files of INPUTFILEdir into inputs
+    void readInputs();
 
     string INPUTFILE;
     string OUTPUTFILE;
@@ -382,7 +473,14 @@ public:
     string premiumName;
 
     //2016
+    /// product numbers of the standard names, filled by RegManagerInfo::initGlobals2()
     map<string,int> stdNameIndexs;
+    /** product number of a standard name, 0 if the market has none.
+        Does not insert into stdNameIndexs */
+    int getStdNameIndex(const string& name) const {
+        map<string,int>::const_iterator it=stdNameIndexs.find(name);
+        return it!=stdNameIndexs.end() ? it->second : 0;
+    }
 
     int   FIXED_OFFFARM_LAB;
     int   FIXED_HIRED_LAB;
@@ -397,18 +495,32 @@ public:
         ENV_MODELING=n;
     };
 
-	void setOption(int* name, int val) {
-		*name = val;
+	void setOption(int RegGlobalsInfo::* name, int val) {
+		this->*name = val;
 	}
 
 	vector<string> commandlineFILES;
-	map<int*, int> options;
+	/// command line options, members so that they apply to copies, too
+	vector<pair<int RegGlobalsInfo::*, int> > options;
+	/// --replications a..b: replications run in this process, -1: one run of repeatNum
+	int REPLICATION_FIRST;
+	int REPLICATION_LAST;
+	/// --jobs: replications running at the same time
+	int JOBS;
     virtual ~RegGlobalsInfo();
     int ARGC;
 	char ** ARGV;
 		
+    /** new stamp for a source of MIP links. Stamps are unique over the
+        simulation, restore() keeps the count, so a restored copy of a
+        source never carries the stamp of a later state */
+    unsigned long newLinkStamp() {
+        return ++link_stamp;
+    }
+
 protected:
     RegGlobalsInfo* obj_backup;
+    unsigned long link_stamp;
 
 };
 
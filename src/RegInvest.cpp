@@ -114,6 +114,7 @@ RegInvestObjectInfo::debug() {
 
 vector <RegInvestObjectInfo >
 RegInvestObjectInfo::initInvestmentCatalog() {
+    const struct investdata& investdata = g->inputs->investdata;
     vector <RegInvestObjectInfo > InvestCatalog;
 
     int noi = investdata.invests.size();
@@ -168,6 +169,7 @@ RegInvestList::RegInvestList(RegGlobalsInfo *G, vector<RegInvestObjectInfo>&I)
     // 9 investment types
     obj_backup=NULL;
     newley_invested.resize((*invest_cat).size());
+    stamp=g->newLinkStamp();
 }
 RegInvestList::RegInvestList(RegInvestList& rh,
                              RegGlobalsInfo* G,
@@ -176,6 +178,7 @@ RegInvestList::RegInvestList(RegInvestList& rh,
     obj_backup=NULL;
     farm_invests=rh.farm_invests;
     newley_invested=rh.newley_invested;
+    stamp=g->newLinkStamp();
 }
 RegInvestList::~RegInvestList() {
     if (obj_backup) delete obj_backup;
@@ -192,11 +195,13 @@ void
 RegInvestList::add(RegInvestObjectInfo i) {
     farm_invests.push_back(i);
     newley_invested[i.getCatalogNumber()]++;
+    stamp=g->newLinkStamp();
 }
 void
 RegInvestList::addTest(RegInvestObjectInfo i) {
     i.setInvestAge(-1);
     farm_invests.push_back(i);
+    stamp=g->newLinkStamp();
 }
 
 void
@@ -267,6 +272,7 @@ RegInvestList::add(int cat_num, int quantity, int cap) {
             // delete pointer to original object
             delete invest;
         }
+        stamp=g->newLinkStamp();
     }
 }
 void
@@ -306,6 +312,7 @@ RegInvestList::removeInvestment() {
         list<RegInvestObjectInfo >::iterator removed;
         removed = remove_if(farm_invests.begin(), farm_invests.end(), CheckAge());
         farm_invests.erase(removed, farm_invests.end());
+        stamp=g->newLinkStamp();
     }
 }
 int
@@ -602,16 +609,14 @@ RegInvestList::getCapacityOfType(int t) {
     return cap;
 }
 
-int RegInvestList::getRandomInvestAge() {
-	string name = "INVESTAGE";
-	
-	return g->getRandomInt(name, g->uni_int_distrib_investAge);
+int RegInvestList::getRandomInvestAge(RegRandomStreams* streams) {
+	return g->getRandomInt(RAND_GEN::INVESTAGE, g->uni_int_distrib_investAge, streams);
 }
 
 void
 RegInvestList::setAsynchronousInvestAge(int farm_age, double *assets,
                                         double *liquidity, double *lt_borrowed_capital,
-                                        const double& equity_interest, const double& rel_invest_age ) {
+                                        const double& equity_interest, const double& rel_invest_age, RegRandomStreams* streams) {
 
     //int catnumber;
     int /*modulo, */investage;
@@ -632,7 +637,7 @@ RegInvestList::setAsynchronousInvestAge(int farm_age, double *assets,
 
         n = (*invest).getEconomicLife();
 
-		int ir = getRandomInvestAge();
+		int ir = getRandomInvestAge(streams);
 		//cout << ir << endl;
 		investage = ir % n;// randlong() % n;
 
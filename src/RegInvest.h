@@ -267,6 +267,11 @@ private:
     /// vector indicating that object was newley invest in
     vector<int> newley_invested;
     RegInvestList* obj_backup;
+    /** link stamp, renewed whenever objects are added to or removed from farm_invests.
+        Capacity, type and labour substitution of an object are set when it is
+        added and never change, so the stamp covers getCapacityOfType() and
+        getNormalizedCapacityOfType(). */
+    unsigned long stamp;
 
 	map<string, int> removed_invs;
 
@@ -274,7 +279,7 @@ public:
 	map<string, int> getRemovedInvests();
 	void resetRemovedInvs();
 
-	int getRandomInvestAge();
+	int getRandomInvestAge(RegRandomStreams* streams);
     double labSubstitution;
     /// destructor
     ~RegInvestList();
@@ -285,9 +290,14 @@ public:
     */
     RegInvestList(RegGlobalsInfo* G, vector<RegInvestObjectInfo>& I);
     RegInvestList(RegInvestList&,RegGlobalsInfo* G, vector<RegInvestObjectInfo>& I);
+    /// without globals there are no stamps, the list is not linked to a MIP
     RegInvestList() {
         obj_backup=NULL;
+        stamp=0;
     };
+    unsigned long getStamp() const {
+        return stamp;
+    }
     void backup();
     void restore();
     /** add investment object i to farm invest list.
@@ -385,7 +395,8 @@ public:
     */
     void setAsynchronousInvestAge(int farm_age, double *assets,
                                   double *liquidity, double *lt_borrowed_capital,
-                                  const double& equity_interest, const double& rel_invest_age);
+                                  const double& equity_interest, const double& rel_invest_age,
+                                  RegRandomStreams* streams);
 
     /// resets all elements of the newly_invested vector to zero
     void setBackNewleyInvestedVector();
@@ -28,6 +28,12 @@ int RegLinkObject::getDestNumber() {
 int RegLinkObject::getType() {
     return type;
 }
+void RegLinkObject::setDestNumber(int dn) {
+    dest_number=dn;
+}
+void RegLinkObject::setDest(double* d) {
+    dest=d;
+}
 bool RegLinkObject::trigger() {
     bool retval=(dest[dest_number]!= res_value) && (dest_kind==0 || dest_kind==2);
     dest[dest_number]= res_value;
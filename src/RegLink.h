@@ -24,7 +24,9 @@
 //Types of Links:
 // 0:Market, 1:Invest, 2:Reference, 3:Number
 class RegProductList;
+class RegLinkTable;
 class RegLinkObject {
+    friend class RegLinkTable;
 public:
     RegLinkObject();
     ~RegLinkObject() {};
@@ -34,6 +36,9 @@ public:
     virtual int getDestKind();
     virtual int getType();
     virtual string debug()=0;
+    /// used when matrix destinations are renumbered to sparse slots
+    void setDestNumber(int);
+    void setDest(double*);
 protected:
     double res_value;
     int value_kind;
@@ -76,6 +81,7 @@ public:
 };
 
 class RegLinkMarketObject : public RegLinkObject {
+    friend class RegLinkTable;
 private:
     RegProductList * source;
 //    int value_kind; //0: getCostsOfNumber();
@@ -91,6 +97,7 @@ public:
     string debug();
 };
 class RegLinkInvestObject : public RegLinkObject {
+    friend class RegLinkTable;
 private:
     RegInvestList * source;
 public:
@@ -103,6 +110,7 @@ public:
 };
 
 class RegLinkReferenceObject : public RegLinkObject {
+    friend class RegLinkTable;
 private:
     double *source;
 
@@ -115,6 +123,7 @@ public:
     string debug();
 };
 class RegLinkNumberObject : public RegLinkObject {
+    friend class RegLinkTable;
 private:
     double value;
 public:
@@ -125,4 +134,5 @@ public:
 
     string debug();
 };
+
 #endif
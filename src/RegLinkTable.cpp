@@ -0,0 +1,216 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in 
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// RegLinkTable.cpp
+//---------------------------------------------------------------------------
+#include <iostream>
+#include <cstdlib>
+#include <set>
+#include <tuple>
+#include "RegLinkTable.h"
+#include "RegLink.h"
+//=================== Link table ======================
+void
+RegLinkTable::Rows::add(int vk, int sn, double f, int dk, int dn) {
+    value_kind.push_back(vk);
+    source_number.push_back(sn);
+    factor.push_back(f);
+    dest_kind.push_back(dk);
+    dest_number.push_back(dn);
+}
+
+void
+RegLinkTable::Rows::clear() {
+    value_kind.clear();
+    source_number.clear();
+    factor.clear();
+    dest_kind.clear();
+    dest_number.clear();
+}
+
+RegLinkTable::RegLinkTable():products(NULL),invests(NULL),
+        products_seen(0),invests_seen(0),numbers_dirty(true) {}
+
+void
+RegLinkTable::build(vector<RegLinkInvestObject*>& il,
+                    vector<RegLinkMarketObject*>& ml,
+                    vector<RegLinkReferenceObject*>& rl,
+                    vector<RegLinkNumberObject*>& nl) {
+    market_costs.clear();
+    market_prices.clear();
+    invest_caps.clear();
+    invest_cat.clear();
+    references.clear();
+    reference_sources.clear();
+    numbers.clear();
+    number_values.clear();
+    products=NULL;
+    invests=NULL;
+
+    // readLink creates some links twice; identical rows are kept once.
+    // The tables are synced in another order than the links were
+    // triggered, which is only the same if no two rows write one cell.
+    set<tuple<int,int,int,int,double,const void*> > seen;
+    set<int> dests;
+    for (unsigned i=0;i<il.size();i++) {
+        RegLinkInvestObject* l=il[i];
+        if (!seen.insert(make_tuple(1,l->value_kind,l->source_number,
+                                    l->dest_kind*0x10000000+l->dest_number,
+                                    l->factor,(const void*)l->source)).second)
+            continue;
+        checkDest(dests,l->dest_kind,l->dest_number);
+        invests=l->source;
+        Rows& r= (l->value_kind==0 || l->value_kind==4) ? invest_caps : invest_cat;
+        r.add(l->value_kind,l->source_number,l->factor,l->dest_kind,l->dest_number);
+    }
+    for (unsigned i=0;i<ml.size();i++) {
+        RegLinkMarketObject* l=ml[i];
+        if (!seen.insert(make_tuple(0,l->value_kind,l->source_number,
+                                    l->dest_kind*0x10000000+l->dest_number,
+                                    l->factor,(const void*)l->source)).second)
+            continue;
+        checkDest(dests,l->dest_kind,l->dest_number);
+        products=l->source;
+        Rows& r= l->value_kind==0 ? market_costs : market_prices;
+        r.add(l->value_kind,l->source_number,l->factor,l->dest_kind,l->dest_number);
+    }
+    for (unsigned i=0;i<rl.size();i++) {
+        RegLinkReferenceObject* l=rl[i];
+        if (!seen.insert(make_tuple(2,0,l->source_number,
+                                    l->dest_kind*0x10000000+l->dest_number,
+                                    0.0,(const void*)l->source)).second)
+            continue;
+        checkDest(dests,l->dest_kind,l->dest_number);
+        references.add(0,l->source_number,1,l->dest_kind,l->dest_number);
+        reference_sources.push_back(l->source);
+    }
+    for (unsigned i=0;i<nl.size();i++) {
+        RegLinkNumberObject* l=nl[i];
+        if (!seen.insert(make_tuple(3,0,0,l->dest_kind*0x10000000+l->dest_number,
+                                    l->value,(const void*)NULL)).second)
+            continue;
+        checkDest(dests,l->dest_kind,l->dest_number);
+        numbers.add(0,0,1,l->dest_kind,l->dest_number);
+        number_values.push_back(l->value);
+    }
+    invalidate();
+}
+
+void
+RegLinkTable::checkDest(set<int>& dests, int dk, int dn) {
+    if (!dests.insert(dk*0x10000000+dn).second) {
+        cout << "ERROR: two links write to the same MIP cell (kind " << dk
+             << ", number " << dn << ")" << endl;
+        exit(2);
+    }
+}
+
+void
+RegLinkTable::invalidate() {
+    products_seen=0;
+    invests_seen=0;
+    numbers_dirty=true;
+}
+
+inline bool
+RegLinkTable::put(double** dest, int dk, int dn, double v) {
+    double& d=dest[dk][dn];
+    bool changed= d!=v && dk!=1;
+    d=v;
+    return changed;
+}
+
+bool
+RegLinkTable::syncMarket(double* mat, double* rhs, double* obj) {
+    if (!products)
+        return false;
+    double* dest[3]={mat,rhs,obj};
+    bool changed=false;
+    if (products_seen!=products->getStamp()) {
+        for (unsigned i=0;i<market_costs.factor.size();i++) {
+            double v=products->getVarCostsOfNumber(market_costs.source_number[i])
+                     *market_costs.factor[i];
+            if (put(dest,market_costs.dest_kind[i],market_costs.dest_number[i],v))
+                changed=true;
+        }
+        products_seen=products->getStamp();
+    }
+    for (unsigned i=0;i<market_prices.factor.size();i++) {
+        int n=market_prices.source_number[i];
+        double v;
+        switch (market_prices.value_kind[i]) {
+        case 1:
+            v=products->getPriceOfNumber(n)*market_prices.factor[i];
+            break;
+        case 2:
+            v=products->getPriceExpectationOfNumber(n)*market_prices.factor[i];
+            break;
+        case 3:
+            v=products->getGmOrGmExpectedOfNumber(n)*market_prices.factor[i];
+            break;
+        default:
+            v=9999;
+        }
+        if (put(dest,market_prices.dest_kind[i],market_prices.dest_number[i],v))
+            changed=true;
+    }
+    return changed;
+}
+
+bool
+RegLinkTable::sync(double* mat, double* rhs, double* obj) {
+    double* dest[3]={mat,rhs,obj};
+    bool changed=false;
+    if (invests && invests_seen!=invests->getStamp()) {
+        for (unsigned i=0;i<invest_caps.factor.size();i++) {
+            int n=invest_caps.source_number[i];
+            double v= invest_caps.value_kind[i]==0 ? invests->getCapacityOfType(n)
+                      : invests->getNormalizedCapacityOfType(n);
+            if (put(dest,invest_caps.dest_kind[i],invest_caps.dest_number[i],
+                    v*invest_caps.factor[i]))
+                changed=true;
+        }
+        invests_seen=invests->getStamp();
+    }
+    for (unsigned i=0;i<invest_cat.factor.size();i++) {
+        int n=invest_cat.source_number[i];
+        double v;
+        switch (invest_cat.value_kind[i]) {
+        case 1:
+            v=invests->getLiqEffectOfNumber(n)*invest_cat.factor[i];
+            break;
+        case 2:
+            v=invests->getBoundEquityCapitalOfNumber(n)*invest_cat.factor[i];
+            break;
+        case 3:
+            v=invests->getAverageCostOfNumber(n)*invest_cat.factor[i];
+            break;
+        default:
+            v=9999;
+        }
+        if (put(dest,invest_cat.dest_kind[i],invest_cat.dest_number[i],v))
+            changed=true;
+    }
+    if (syncMarket(mat,rhs,obj))
+        changed=true;
+    for (unsigned i=0;i<reference_sources.size();i++)
+        if (put(dest,references.dest_kind[i],references.dest_number[i],
+                *reference_sources[i]))
+            changed=true;
+    if (numbers_dirty) {
+        for (unsigned i=0;i<number_values.size();i++)
+            if (put(dest,numbers.dest_kind[i],numbers.dest_number[i],number_values[i]))
+                changed=true;
+        numbers_dirty=false;
+    }
+    return changed;
+}
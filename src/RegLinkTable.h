@@ -0,0 +1,93 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in 
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+//---------------------------------------------------------------------------
+#ifndef RegLinkTableH
+#define RegLinkTableH
+#include <vector>
+#include <set>
+using namespace std;
+
+class RegProductList;
+class RegInvestList;
+class RegLinkInvestObject;
+class RegLinkMarketObject;
+class RegLinkReferenceObject;
+class RegLinkNumberObject;
+
+/** RegLinkTable class.
+    Flat copy of the market, invest, reference and number links of one MIP,
+    one table per source kind, so that updating the MIP needs no virtual
+    trigger() per link. Rows whose values depend only on the var costs of
+    the product list or on the objects in the invest list are written
+    only when the stamp of that list differs from the stamp seen at the
+    last sync; number links only after invalidate(). The capacity rows
+    read capacity, type and (normalised) labour substitution of the farm
+    objects, which are fixed when an object is added, so the add/remove
+    stamp of the invest list covers them.
+    Prices, catalog values (liquidity effect, bound equity capital,
+    average cost) and farm references have no stamp; they change every
+    period in the shared catalogs or at any time in the farm, and are
+    read and compared on each sync.
+    build() stops the program if two links write the same cell, since
+    the order of the tables is not the order of the links.
+    Destinations are kept as kind and index, the arrays are passed to
+    sync(), so copies of the MIP need not re-point the table.
+*/
+class RegLinkTable {
+public:
+    RegLinkTable();
+    /// fill the tables from initialised link objects
+    void build(vector<RegLinkInvestObject*>&, vector<RegLinkMarketObject*>&,
+               vector<RegLinkReferenceObject*>&, vector<RegLinkNumberObject*>&);
+    /// forget the seen stamps, e.g. after cells were set by other means
+    void invalidate();
+    /** write all changed sources to mat_val, rhs and obj
+        @return true if a matrix or objective coefficient changed */
+    bool sync(double* mat, double* rhs, double* obj);
+    /// write the market links only
+    bool syncMarket(double* mat, double* rhs, double* obj);
+private:
+    struct Rows {
+        vector<int> value_kind;
+        vector<int> source_number;
+        vector<double> factor;
+        vector<int> dest_kind;
+        vector<int> dest_number;
+        void add(int vk, int sn, double f, int dk, int dn);
+        void clear();
+    };
+    /// exits if another row writes the destination
+    static void checkDest(set<int>& dests, int dk, int dn);
+    /// writes v to the destination, true if a mat or obj value changed
+    static bool put(double** dest, int dk, int dn, double v);
+
+    RegProductList* products;
+    RegInvestList* invests;
+    /// market links on var costs (value kind 0)
+    Rows market_costs;
+    /// market links on prices and gross margins
+    Rows market_prices;
+    /// invest links on farm capacities (value kinds 0 and 4)
+    Rows invest_caps;
+    /// invest links on catalog values
+    Rows invest_cat;
+    Rows references;
+    vector<double*> reference_sources;
+    Rows numbers;
+    vector<double> number_values;
+
+    unsigned long products_seen;
+    unsigned long invests_seen;
+    bool numbers_dirty;
+};
+#endif
@@ -14,6 +14,7 @@
 //---------------------------------------------------------------------------
 #include <fstream>
 #include <stdio.h>
+#include <math.h>
 #include <time.h>
 #include <vector>
 #include <sstream>
@@ -21,6 +22,8 @@
 #include <istream>
 #include <iomanip>
 #include <filesystem>
+#include <chrono>
+#include <mutex>
 
 #include "RegLpD.h"
 #include "RegManager.h"
@@ -56,11 +59,22 @@ o<<" x"<<no;
 return o.str();
 }
 
+// replications running at once (JOBS) share the MIP cache and write the
+// debug files of failed solves
+static mutex shared_mutex;
+// glpk 4.45 keeps its environment (memory bookkeeping, terminal output) in
+// one process wide pointer and is not reentrant, so every call into it,
+// from any problem and any thread, takes this lock
+static mutex glpk_mutex;
+
 RegLpInfo::RegLpInfo() {
     obj_backup=NULL;
+    farm=NULL;
     nzspace = 0;
     ofstream out;
     flat_copy=false;
+    coefs_changed=true;
+    warm_start=false;
 }
 
 RegLpInfo::~RegLpInfo() {
@@ -94,6 +108,7 @@ RegLpInfo::~RegLpInfo() {
 }
 void
 RegLpInfo::debug(string filename) {
+    const struct matrixdata& matrixdata = g->inputs->matrixdata;
     ofstream out;
     out.open(filename.c_str(),ios::trunc);
     if (objsen == -1)
@@ -112,7 +127,7 @@ RegLpInfo::debug(string filename) {
     for (int i=0;i<numrows;i++) {
         out << matrixdata.rownames[i]<<"\t";
         for (int j=0;j<numcols;j++) {
-            out << mat_val[i+j*numrows] << "\t";
+            out << getCellValue(j,i) << "\t";
         }
         switch (sense[i]) {
         case 'L':
@@ -169,47 +184,46 @@ RegLpInfo::debug(string filename) {
     out.close();
 }
 
-static    map <string, int> colindex;
-static    map <string, int> rowindex;
-
-static map <pair<int, int>, bool> linkmat;
-static map <int, bool> linkobj;
-
-static map <string,int> marketId;
-static map < string, int> investId;
-
-static void mkIDs() {
-    int msz = marketdata.products.size();
-    int isz = investdata.invests.size();
-    for (int i = 0 ; i < msz; i++)
-        marketId[marketdata.products[i].name]=i;
-    for (int i = 0; i< isz; i++)
-        investId[investdata.invests[i].name]=i;
-    return;
+// the index of name, 0 for names the index does not have
+static int indexOf(const map <string, int>& index, const string& name) {
+    map<string, int>::const_iterator it = index.find(name);
+    return it!=index.end() ? it->second : 0;
 }
 
+// the indexes are built by RegInputData::readfiles(); -1 for unknown
+// names, which the bound setters and getValOfIndex() ignore
 int RegLpInfo::getColIndex(string s) {
-	return colindex[s];
+	const map <string, int>& colindex = g->inputs->colindex;
+	map<string, int>::const_iterator it = colindex.find(s);
+	return it!=colindex.end() ? it->second : -1;
 }
 
 int RegLpInfo::getRowIndex(string s) {
-	return rowindex[s];
+	const map <string, int>& rowindex = g->inputs->rowindex;
+	map<string, int>::const_iterator it = rowindex.find(s);
+	return it!=rowindex.end() ? it->second : -1;
 }
 
 double RegLpInfo::getValOfIndex(int id) {
+	if (id < 0 || id >= (int)x.size())
+		return 0;
 	return x[id];
 }
 
 void
 RegLpInfo::setupMatrix(RegGlobalsInfo* G) {
+    const struct matrixdata& matrixdata = G->inputs->matrixdata;
+    const struct objlinkdata& objlinkdata = G->inputs->objlinkdata;
+    const struct matlinkdata& matlinkdata = G->inputs->matlinkdata;
+    const struct marketdata& marketdata = G->inputs->marketdata;
+    const map <string, int>& colindex = G->inputs->colindex;
+    const map <string, int>& rowindex = G->inputs->rowindex;
+    // destinations of the links read from the input
+    map <pair<int, int>, bool> linkmat;
+    map <int, bool> linkobj;
     g = G;
 
-    for (unsigned int i =0 ; i< matrixdata.rownames.size();i++)
-        rowindex[matrixdata.rownames[i]]=i;
-    for (unsigned int i =0 ; i< matrixdata.colnames.size();i++)
-        colindex[matrixdata.colnames[i]]=i;
-
-    if ((rowindex["LIQUIDITY"]!=0) || (rowindex["FINANCING_RULE"]!=1)) {
+    if ((indexOf(rowindex, "LIQUIDITY")!=0) || (indexOf(rowindex, "FINANCING_RULE")!=1)) {
         cout << "ERROR: The first rows must be LIQUIDITY and FINANCING_RULE ! " << endl;
         exit(2);
     }
@@ -218,15 +232,11 @@ RegLpInfo::setupMatrix(RegGlobalsInfo* G) {
    numcols= matrixdata.colnames.size();
 
   // Read in Matrix
-    mat_val.resize(numrows*numcols);
-    int index=0;
     nzspace=0;
     for (int i=0;i<numcols;i++) {
         for (int j=0;j<numrows;j++) {
-            mat_val[index]=matrixdata.mat[j][i];
-            if (mat_val[index]!=0)
+            if (matrixdata.mat[j][i]!=0)
                 nzspace++;
-            index++;
         }
     }
 
@@ -236,15 +246,14 @@ RegLpInfo::setupMatrix(RegGlobalsInfo* G) {
         cap_links.push_back(readLink(i,1));
     }
 
-    mkIDs();
     // Read in Link for Objective Function
     for (unsigned int i=0;i< objlinkdata.objlinks.size();i++) {
         // 2 for obj
-        int pos = colindex[objlinkdata.objlinks[i].name];
+        int pos = indexOf(colindex, objlinkdata.objlinks[i].name);
         obj_links.push_back(readLink(i,2));
         linkobj[pos]=true;
     }
-    stdObjLink();
+    stdObjLink(linkobj);
 
     // Read in Links for Matrix
     //0 liquidity, 1 financing_rule
@@ -253,8 +262,8 @@ RegLpInfo::setupMatrix(RegGlobalsInfo* G) {
 
     for ( int i =0; i< msz; i++) {
         //  0 for mat
-        int r= rowindex[matlinkdata.matlinks[i].row];
-        int c= colindex[matlinkdata.matlinks[i].col];
+        int r= indexOf(rowindex, matlinkdata.matlinks[i].row);
+        int c= indexOf(colindex, matlinkdata.matlinks[i].col);
         
 		RegLinkObject * link = readLink(i,0);
 		if (link) { // kann null sein ohne soilservice 
@@ -262,7 +271,34 @@ RegLpInfo::setupMatrix(RegGlobalsInfo* G) {
 			linkmat[pair<int,int>(r,c)]=true;
 		}
     }
-    stdMatLink();
+    stdMatLink(linkmat);
+
+    // sparse pattern: structural non-zeros and destinations of matrix links
+    vector<RegLinkObject*> links = getAllLinks();
+    vector<bool> used(numrows*numcols, false);
+    for (unsigned int i=0;i<links.size();i++)
+        if (links[i]->getDestKind()==0)
+            used[links[i]->getDestNumber()]=true;
+
+    mat_beg.resize(numcols+1);
+    vector<int> slot(numrows*numcols, -1);
+    for (int i=0;i<numcols;i++) {
+        mat_beg[i]=mat_ind.size();
+        for (int j=0;j<numrows;j++) {
+            if (matrixdata.mat[j][i]!=0 || used[i*numrows+j]) {
+                slot[i*numrows+j]=mat_ind.size();
+                mat_ind.push_back(j);
+                mat_val.push_back(matrixdata.mat[j][i]);
+            }
+        }
+    }
+    mat_beg[numcols]=mat_ind.size();
+    mat_xslots.assign(numcols, vector<int>());
+
+    // links write to slots instead of dense cells c*numrows+r
+    for (unsigned int i=0;i<links.size();i++)
+        if (links[i]->getDestKind()==0)
+            links[i]->setDestNumber(slot[links[i]->getDestNumber()]);
 
     //------ PREPARATION OF MIP PROBLEM --------
 
@@ -292,7 +328,7 @@ RegLpInfo::setupMatrix(RegGlobalsInfo* G) {
     for (int i = 0; i < numrows; i++) {
         sense[i]= 'L';
 		if (g->YoungFarmer) {
-			if (rowindex["PAY_CONDITION_YOUNG_FARMER"] == i)
+			if (indexOf(rowindex, "PAY_CONDITION_YOUNG_FARMER") == i)
 				sense[i] = 'E';
 		}
     }
@@ -307,8 +343,8 @@ RegLpInfo::setupMatrix(RegGlobalsInfo* G) {
     prodcols = marketdata.products.size()+1;    //always right with 2 ? 
     //g->EXCESS_LU = colindex.find("EXCESS_LU")!=colindex.end() ? colindex["EXCESS_LU"] : -1;
     //g->LU_UPPER_LIMIT = colindex.find("LU_UPPER_LIMIT")!=colindex.end() ? colindex["LU_UPPER_LIMIT"] : -1;
-    g->stdNameIndexs["EXCESS_LU"] = colindex.find("EXCESS_LU")!=colindex.end() ? colindex["EXCESS_LU"] : -1;
-    g->stdNameIndexs["LU_UPPER_LIMIT"] = colindex.find("LU_UPPER_LIMIT")!=colindex.end() ? colindex["LU_UPPER_LIMIT"] : -1;
+    int excess_lu = getColIndex("EXCESS_LU");
+    int lu_upper_limit = getColIndex("LU_UPPER_LIMIT");
     for (int i = 0; i < numcols; i++) {
         lb[i] = 0.0;
         if (i < prodcols) { 
@@ -318,10 +354,10 @@ RegLpInfo::setupMatrix(RegGlobalsInfo* G) {
             ub[i] = +1E30;
         }
     }
-    if (g->stdNameIndexs["EXCESS_LU"] >=0)
-        ub[g->stdNameIndexs["EXCESS_LU"]] = 0;
-    if (g->stdNameIndexs["LU_UPPER_LIMIT"] >= 0)
-        ub[g->stdNameIndexs["LU_UPPER_LIMIT"]] = 0;
+    if (excess_lu >=0)
+        ub[excess_lu] = 0;
+    if (lu_upper_limit >= 0)
+        ub[lu_upper_limit] = 0;
 
     // set to maximistion problem
     objsen=-1;
@@ -329,54 +365,47 @@ RegLpInfo::setupMatrix(RegGlobalsInfo* G) {
 
 bool
 RegLpInfo::updateLpValues() {
-    bool changed=false;
-    for (unsigned i=0;i<invest_links.size();i++)
-        if (invest_links[i]->trigger()) changed=true;
-    for (unsigned i=0;i<market_links.size();i++)
-        if (market_links[i]->trigger()) changed=true;
-    for (unsigned i=0;i<reference_links.size();i++)
-        if (reference_links[i]->trigger()) changed=true;
-    for (unsigned i=0;i<number_links.size();i++)
-        if (number_links[i]->trigger()) changed=true;
+    bool changed=link_table.sync(&(*mat_val.begin()),&(*rhs.begin()),&(*obj.begin()));
 	if (g->HAS_SOILSERVICE){
 		for (unsigned i=0;i<yield_links.size();i++)
 			if (yield_links[i]->trigger()) changed=true;
 	}
+	if (changed) coefs_changed=true;
 	return changed;
 }
 void
 RegLpInfo::updateLand() {
     // land_links is pointer to object of type RegLinkObject
     for (unsigned i=0;i < land_links.size();i++)
-        land_links[i]->trigger();
+        if (land_links[i]->trigger()) coefs_changed=true;
 }
 
 void
 RegLpInfo::updateYield() {
     for (unsigned i=0;i < yield_links.size();i++)
-        yield_links[i]->trigger();
+        if (yield_links[i]->trigger()) coefs_changed=true;
 }
 
 void
 RegLpInfo::updatePaymentEntitlement() {
     for (unsigned i=0;i < incomepay_links.size();i++)
-        incomepay_links[i]->trigger();
+        if (incomepay_links[i]->trigger()) coefs_changed=true;
 }
 void
 RegLpInfo::updateCapacities() {
     for (unsigned i=0;i<cap_links.size();i++) {
-        cap_links[i]->trigger();
+        if (cap_links[i]->trigger()) coefs_changed=true;
     }
 }
 void
 RegLpInfo::updateMatrix() {
     for (unsigned i=0;i<mat_links.size();i++)
-        mat_links[i]->trigger();
+        if (mat_links[i]->trigger()) coefs_changed=true;
 }
 void
 RegLpInfo::updateObjectiveFunction() {
     for (unsigned i=0;i<obj_links.size();i++)
-        obj_links[i]->trigger();
+        if (obj_links[i]->trigger()) coefs_changed=true;
 }
 
 
@@ -391,18 +420,19 @@ void RegLpInfo::resetInvsUbs() {
 }
 
 void RegLpInfo::updateBoundsYoungFarmer() {
-	setUBound(colindex["MAX_PAY_YOUNG_FARMER"], 1);
-	setUBound(colindex["NON_YOUNG_FARMER"], 1);
-	setUBoundInf(colindex["PAY_YOUNG_FARMER"]);
-	setLBound(colindex["YEARS_YOUNG_FARMER"], 1);
-	setUBoundInf(colindex["YEARS_YOUNG_FARMER"]);
+	setUBound(getColIndex("MAX_PAY_YOUNG_FARMER"), 1);
+	setUBound(getColIndex("NON_YOUNG_FARMER"), 1);
+	setUBoundInf(getColIndex("PAY_YOUNG_FARMER"));
+	setLBound(getColIndex("YEARS_YOUNG_FARMER"), 1);
+	setUBoundInf(getColIndex("YEARS_YOUNG_FARMER"));
 }
 
 void RegLpInfo::resetRestrictedInvsUbs(set<string> rs) {
+	const map <string, int>& colindex = g->inputs->colindex;
 	for (auto x : rs) {
 		for (auto p : colindex) {
 			if (p.first.rfind(x, 0) == 0) {
-				int i = colindex[p.first];
+				int i = p.second;
 				if (i>= prodcols)
 					ub[i] = 0;
 			}
@@ -438,7 +468,9 @@ RegLpInfo::Lp(RegProductList* PList, vector<int >& ninv, bool prod, int maxofffa
 				}
 
 				for (auto x : restInvs) {
-					ub[colindex[x.first]] = x.second;
+					int col = getColIndex(x.first);
+					if (col >= 0)
+						ub[col] = x.second;
 					//cout << x.first << "\t" << x.second << " <==> ";
 				}
 			}else {  //LU cap
@@ -457,10 +489,11 @@ RegLpInfo::Lp(RegProductList* PList, vector<int >& ninv, bool prod, int maxofffa
 	//#else
    
 #ifdef GNU_SOLVER
-	glp_solve();
+	glp_cachedSolve();
 
 	if (stat != GLP_OPT)
 	{
+		lock_guard<mutex> lock(shared_mutex);
 		//g->V++;  //misbrauch von V
 		stringstream ss;
 		ss << "gdebug" << g->tInd << ".txt";
@@ -476,8 +509,23 @@ RegLpInfo::Lp(RegProductList* PList, vector<int >& ninv, bool prod, int maxofffa
 		debug(ss.str().c_str());
 	}
 #endif
-	HPROBLEM lp = loadlp(PROBNAME, numcols, numrows, objsen, &(*obj.begin()), &(*rhs.begin()), (LPBYTEARG)&(*sense.begin()), NULL, NULL,
-		NULL, &(*mat_val.begin()), &(*lb.begin()), &(*ub.begin()), NULL, numcols, numrows, nzspace);
+	// Frontline takes the columns one after the other, mat_val has the
+	// appended cells at the end, so the columns are gathered first
+	vector<int> matbeg(numcols), matcnt(numcols), matind;
+	vector<double> matval;
+	vector<int> ind(numrows+1);
+	vector<double> val(numrows+1);
+	for (int j = 0; j < numcols; j++) {
+		int len = getMatColumn(j, &ind[0], &val[0]);
+		matbeg[j] = matind.size();
+		matcnt[j] = len;
+		for (int k = 1; k <= len; k++) {
+			matind.push_back(ind[k]-1);
+			matval.push_back(val[k]);
+		}
+	}
+	HPROBLEM lp = loadlp(PROBNAME, numcols, numrows, objsen, &(*obj.begin()), &(*rhs.begin()), (LPBYTEARG)&(*sense.begin()), &matbeg[0], &matcnt[0],
+		&matind[0], &matval[0], &(*lb.begin()), &(*ub.begin()), NULL, numcols, numrows, (int)matval.size());
 	setintparam(lp, PARAM_ARGCK, 1);
 	//setdblparam(lp,PARAM_EPGAP,0.01);
 	setdblparam(lp, PARAM_TILIM, 60);
@@ -570,7 +618,7 @@ RegLpInfo::Lp(RegProductList* PList, vector<int >& ninv, bool prod, int maxofffa
 			string debdir = "DebMIPs/";
 		
 			string tinputdir;
-			tinputdir=rtrim(inputdir, '/');
+			tinputdir=rtrim(g->inputs->inputdir, '/');
 				
 			fs::path inpdir(tinputdir);
 			fs::path pdir = inpdir.parent_path();
@@ -620,87 +668,351 @@ RegLpInfo::Lp(RegProductList* PList, vector<int >& ninv, bool prod, int maxofffa
 } 
 
 #ifdef GNU_SOLVER
-#define MAX_NUM 20000
-void RegLpInfo::glp_solve(){
-	glp_prob *glp;
-	glp_smcp cparm;
-	glp_init_smcp(&cparm);
-	cparm.msg_lev=GLP_MSG_OFF;
-	cparm.tm_lim=60000; //milliseconds
+RegGlpProblem::~RegGlpProblem() {
+	lock_guard<mutex> lock(glpk_mutex);
+	if (glp) glp_delete_prob(glp);
+}
 
-	int ia[1+MAX_NUM], ja[1+MAX_NUM];  // ? globale constant 
-	double ar[1+MAX_NUM]; //array of the non-zero coefficients 
+void RegLpInfo::glp_setRowBnds(int i) {
+	glp_prob* glp = glpprob->glp;
+	switch (sense[i-1]) {
+	case 'L':
+		 glp_set_row_bnds(glp, i, GLP_UP, 0.0, rhs[i-1]); //auxiliary variables (rows) upper limits
+		 break;
+	case 'G':
+		 glp_set_row_bnds(glp, i, GLP_LO, rhs[i-1], 0.0); //auxiliary variables (rows) lower limits
+		 break;
+	case 'E':
+		 glp_set_row_bnds(glp, i, GLP_FX, rhs[i-1], rhs[i-1]); //auxiliary variables (rows) fixed value
+		 break;
+	default: cout << "sense not one of L, E, or G \n";
+	}
+}
 
-	glp=glp_create_prob();
+void RegLpInfo::glp_setColBnds(int i) {
+	glp_prob* glp = glpprob->glp;
+	if (ub[i-1]==INFBOUND)
+		glp_set_col_bnds(glp, i, GLP_LO, lb[i-1], 0.0);
+	else {
+		if (ub[i-1]==lb[i-1])
+			glp_set_col_bnds(glp, i, GLP_FX, lb[i-1], ub[i-1]);
+		else
+			glp_set_col_bnds(glp, i, GLP_DB, lb[i-1], ub[i-1]);
+	}
+}
+
+// creates the GLPK problem and loads it completely
+void RegLpInfo::glp_build() {
+	glpprob = make_shared<RegGlpProblem>();
+	glp_prob* glp = glp_create_prob();
+	glpprob->glp = glp;
 	glp_set_prob_name(glp,"Agent");
 	glp_set_obj_dir(glp,GLP_MAX);
 
 	glp_add_rows(glp, numrows);
+	for (int i=1;i<=numrows;i++)
+		glp_setRowBnds(i);
 
-    for (int i=1;i<numrows+1;i++) {
-		switch (sense[i-1]) {
-		case 'L': 
-			 glp_set_row_bnds(glp, i, GLP_UP, 0.0, rhs[i-1]); //auxiliary variables (rows) upper limits
-			break;
-		case 'G': 
-			 glp_set_row_bnds(glp, i, GLP_LO, rhs[i-1], 0.0); //auxiliary variables (rows) lower limits
-			break;
-		case 'E': 
-			 glp_set_row_bnds(glp, i, GLP_FX, rhs[i-1], rhs[i-1]); //auxiliary variables (rows) fixed value
-			break;
-		default: cout << "sense not one of L, E, or G \n";
+	glp_add_cols(glp, numcols);
+	for (int i=1;i<=numcols;i++) {
+		glp_set_obj_coef(glp, i, obj[i-1]);
+		glp_setColBnds(i);
+	}
+
+	glp_loadMatrix();
+
+	// setting integer parameters
+	for (int i=0;i<numcols;i++) {
+		if (ctype[i] == 'I') {
+			glp_set_col_kind(glp, i+1, GLP_IV);
 		}
-    }
+	}
 
-    // adding columns (variables) with bounds and obj coefficients:
-    glp_add_cols(glp, numcols);
-    for (int i=1;i<numcols+1;i++) {
-        glp_set_obj_coef(glp, i, obj[i-1]);
-        if (ub[i-1]==INFBOUND) {
-            glp_set_col_bnds(glp, i, GLP_LO, lb[i-1], 0.0);
-        } else {
-            if (ub[i-1]==lb[i-1])
-                glp_set_col_bnds(glp, i, GLP_FX, lb[i-1], ub[i-1]);
-            else
-                glp_set_col_bnds(glp, i, GLP_DB, lb[i-1], ub[i-1]);
-        }
-    }
+	glpprob->rhs = rhs;
+	glpprob->sense = sense;
+	glpprob->obj = obj;
+	glpprob->lb = lb;
+	glpprob->ub = ub;
+	coefs_changed = false;
+}
 
-    // creating the three arrays needed for loading matrix: rows, column, value
-    // zero coefficients are not allowed
-    int matrix_counter=1;
-    int nz_counter=1;
-    for (int j=1;j<numcols+1;j++) {
-        for (int i=1;i<numrows+1;i++) {
-            if (mat_val[matrix_counter-1] != 0) {
-                ia[nz_counter] = i;
-                ja[nz_counter] = j;
-                ar[nz_counter] = mat_val[matrix_counter-1];
-                nz_counter++;
-                if (nz_counter>=MAX_NUM) throw 1; // exeption: more non-zeros than declared
-            }
-            matrix_counter++;
-        }
-    }
+// loads the whole constraint matrix; zero coefficients are not passed
+void RegLpInfo::glp_loadMatrix() {
+	vector<int> ia(1+mat_val.size()), ja(1+mat_val.size());
+	vector<double> ar(1+mat_val.size());
+	vector<int> ind(1+numrows);
+	vector<double> val(1+numrows);
+	int nz_counter=0;
+	for (int j=0;j<numcols;j++) {
+		int len = getMatColumn(j, &ind[0], &val[0]);
+		for (int k=1;k<=len;k++) {
+			++nz_counter;
+			ia[nz_counter] = ind[k];
+			ja[nz_counter] = j+1;
+			ar[nz_counter] = val[k];
+		}
+	}
+	glp_load_matrix(glpprob->glp, nz_counter, &ia[0], &ja[0], &ar[0]);
+	glpprob->mat_val = mat_val;
+}
 
-	// loading the constrain coefficient matrix..
-    glp_load_matrix(glp, nz_counter-1, ia, ja, ar);
+// passes only the entries changed since the last solve to GLPK
+void RegLpInfo::glp_update() {
+	RegGlpProblem& p = *glpprob;
+	glp_prob* glp = p.glp;
 
-/*	// solving the problem with only continuous variables..(no pre-solver for mip)
-    int st = glp_simplex(glp, &cparm);
+	for (int i=0;i<numrows;i++) {
+		if (rhs[i] != p.rhs[i] || sense[i] != p.sense[i]) {
+			glp_setRowBnds(i+1);
+			p.rhs[i] = rhs[i];
+			p.sense[i] = sense[i];
+		}
+	}
 
-	if (st) {  //st==0 optimal
-		cout << "error during solving lp:" << st << "\n";
-		debug("gdebug1.txt");
+	for (int i=0;i<numcols;i++) {
+		if (obj[i] != p.obj[i]) {
+			glp_set_obj_coef(glp, i+1, obj[i]);
+			p.obj[i] = obj[i];
+		}
+		if (lb[i] != p.lb[i] || ub[i] != p.ub[i]) {
+			glp_setColBnds(i+1);
+			p.lb[i] = lb[i];
+			p.ub[i] = ub[i];
+		}
 	}
-//*/
-	// setting integer parameters
-    for (int i=0;i<numcols;i++) {
-        if (ctype[i] == 'I') {
-            glp_set_col_kind(glp, i+1, GLP_IV);
-        }
-    }
-	
+
+	// only links reporting a change or changeMatrix touch coefficients
+	if (!coefs_changed)
+		return;
+	coefs_changed = false;
+
+	// slots were added or dropped (restore): load the whole matrix
+	if (mat_val.size() != p.mat_val.size()) {
+		glp_loadMatrix();
+		return;
+	}
+
+	vector<bool> changed(numcols, false);
+	for (int j=0;j<numcols;j++) {
+		for (int s=mat_beg[j];s<mat_beg[j+1];s++) {
+			if (mat_val[s] != p.mat_val[s]) {
+				changed[j] = true;
+				break;
+			}
+		}
+	}
+	for (int j=0;j<numcols;j++) {
+		for (unsigned int k=0;k<mat_xslots[j].size();k++) {
+			int s = mat_xslots[j][k];
+			if (mat_val[s] != p.mat_val[s])
+				changed[j] = true;
+		}
+	}
+
+	vector<int> ind(numrows+1);
+	vector<double> val(numrows+1);
+	for (int j=0;j<numcols;j++) {
+		if (!changed[j])
+			continue;
+		int len = getMatColumn(j, &ind[0], &val[0]);
+		glp_set_mat_col(glp, j+1, len, &ind[0], &val[0]);
+	}
+	p.mat_val = mat_val;
+}
+
+// optimal relaxation from the basis left by the previous solve
+bool RegLpInfo::glp_relax() {
+	glp_prob* glp = glpprob->glp;
+	glp_smcp sparm;
+	glp_init_smcp(&sparm);
+	sparm.msg_lev = GLP_MSG_OFF;
+	sparm.tm_lim = 60000; //milliseconds
+	int r = glp_simplex(glp, &sparm);
+	if (r == GLP_EBADB || r == GLP_ESING || r == GLP_ECOND) {
+		glp_adv_basis(glp, 0);
+		r = glp_simplex(glp, &sparm);
+	}
+	return r == 0 && glp_get_status(glp) == GLP_OPT;
+}
+
+// integer columns of the relaxation within the integrality tolerance of intopt
+bool RegLpInfo::glp_isIntegral() {
+	glp_prob* glp = glpprob->glp;
+	for (int i=0;i<numcols;i++) {
+		if (ctype[i] != 'I')
+			continue;
+		double v = glp_get_col_prim(glp, i+1);
+		if (fabs(v - floor(v+0.5)) > 1e-5)
+			return false;
+	}
+	return true;
+}
+
+// GLPK takes an incumbent without checking it against the rows, so rows and
+// bounds are checked here
+bool RegLpInfo::glp_isFeasible(const vector<double>& xs) {
+	const double tol = 1e-7;
+	for (int j=0;j<numcols;j++) {
+		double v = xs[j];
+		if (v < lb[j] - tol*(1+fabs(lb[j])))
+			return false;
+		if (ub[j] != INFBOUND && v > ub[j] + tol*(1+fabs(ub[j])))
+			return false;
+	}
+	vector<double> act(numrows, 0);
+	for (int j=0;j<numcols;j++)
+		for (int s=mat_beg[j];s<mat_beg[j+1];s++)
+			act[mat_ind[s]] += mat_val[s]*xs[j];
+	for (int j=0;j<numcols;j++)
+		for (unsigned int k=0;k<mat_xslots[j].size();k++) {
+			int s = mat_xslots[j][k];
+			act[mat_ind[s]] += mat_val[s]*xs[j];
+		}
+	for (int i=0;i<numrows;i++) {
+		double t = tol*(1+fabs(rhs[i]));
+		if ((sense[i]=='L' || sense[i]=='E') && act[i] > rhs[i] + t)
+			return false;
+		if ((sense[i]=='G' || sense[i]=='E') && act[i] < rhs[i] - t)
+			return false;
+	}
+	return true;
+}
+
+struct GlpCallbackInfo {
+	/// incumbent or NULL
+	const double* x;
+	bool done;
+	/// problem solved by the branch and bound (the presolved copy if presolve is on)
+	glp_prob* mip;
+	int itcnt;
+	int nodes;
+	double gap;
+};
+
+// simplex iterations done on lp so far; glpk 4.45 has no glp_get_it_cnt yet
+static int glp_iterations(glp_prob* lp) {
+#if GLP_MAJOR_VERSION >= 5
+	return glp_get_it_cnt(lp);
+#else
+	return lpx_get_int_parm(lp, LPX_K_ITCNT);
+#endif
+}
+
+// passes the incumbent once to the branch and bound and tracks its work
+static void glp_callback(glp_tree* tree, void* info) {
+	GlpCallbackInfo* h = static_cast<GlpCallbackInfo*>(info);
+	h->mip = glp_ios_get_prob(tree);
+	h->itcnt = glp_iterations(h->mip);
+	glp_ios_tree_size(tree, NULL, NULL, &h->nodes);
+	h->gap = glp_ios_mip_gap(tree);
+	if (glp_ios_reason(tree) != GLP_IHEUR || !h->x || h->done)
+		return;
+	h->done = true;
+	glp_ios_heur_sol(tree, h->x);
+}
+
+template<class Put> void RegLpInfo::mipImage(Put& put) {
+	put(&numrows, sizeof(numrows));
+	put(&numcols, sizeof(numcols));
+	put(&sense[0], numrows*sizeof(char));
+	put(&rhs[0], numrows*sizeof(double));
+	put(&ctype[0], numcols*sizeof(char));
+	put(&obj[0], numcols*sizeof(double));
+	put(&lb[0], numcols*sizeof(double));
+	put(&ub[0], numcols*sizeof(double));
+	vector<int> ind(numrows+1);
+	vector<double> val(numrows+1);
+	for (int j=0;j<numcols;j++) {
+		int len = getMatColumn(j, &ind[0], &val[0]);
+		put(&len, sizeof(len));
+		put(&ind[1], len*sizeof(int));
+		put(&val[1], len*sizeof(double));
+	}
+}
+
+string RegLpInfo::mipKey() {
+	string key;
+	auto put = [&key](const void* p, size_t n) { key.append((const char*)p, n); };
+	mipImage(put);
+	return key;
+}
+
+uint64_t RegLpInfo::mipHash() {
+	RegMipCache::Hasher h;
+	auto put = [&h](const void* p, size_t n) { h.put(p, n); };
+	mipImage(put);
+	return h.value();
+}
+
+// solves through the MIP cache of the simulation, only optimal results are kept;
+// solves starting from the basis of the previous solve (warm start,
+// LP_RELAXATION_FIRST) may end in another optimum and bypass the cache
+void RegLpInfo::glp_cachedSolve() {
+	if (!g->mipcache || warm_start || g->LP_RELAXATION_FIRST) {
+		glp_solve();
+		return;
+	}
+	chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+	// the image is only built to confirm a hit or for a new entry
+	uint64_t hash = mipHash();
+	string key;
+	if (g->mipcache->mayContain(hash))
+		key = mipKey();
+	RegMipCache::Result r;
+	if (g->mipcache->find(hash, key, r)) {
+		stat = r.stat;
+		objval = r.objval;
+		x = r.x;
+		if (g->MIP_LOG)
+			logSolve(true, chrono::duration<double>(chrono::steady_clock::now()-t0).count());
+		return;
+	}
+	glp_solve();
+	if (stat == GLP_OPT) {
+		r.stat = stat;
+		r.objval = objval;
+		r.x = x;
+		if (key.empty())
+			key = mipKey();
+		g->mipcache->insert(hash, key, r);
+	}
+}
+
+void RegLpInfo::logSolve(bool cached, double time) {
+	{
+		lock_guard<mutex> lock(shared_mutex);
+		if (!g->miplog)
+			g->miplog = make_shared<RegMipLog>(g->OUTPUTFILE);
+	}
+	RegMipLog::Record r;
+	r.phase = phaseName(g->tPhase);
+	r.iteration = g->tIter;
+	r.farm_id = farm ? farm->getFarmId() : g->tFarmId;
+	r.farm_name = farm ? farm->getFarmName() : g->tFarmName;
+	r.cached = cached;
+	r.status = stat;
+	r.time = time;
+	if (!cached)
+		r.stats = glpprob->stats;
+	g->miplog->add(r);
+}
+
+// takes the optimal relaxation as solution, integer columns rounded
+void RegLpInfo::glp_lpSolution() {
+	glp_prob* glp = glpprob->glp;
+	stat = GLP_OPT;
+	objval = glp_get_obj_val(glp);
+	for (int i=0; i<numcols; i++) {
+		double temp = glp_get_col_prim(glp, i+1);
+		x[i] = ctype[i]=='I' ? floor(temp+0.5) : temp;
+	}
+}
+
+// branch and bound, without presolve from the optimal relaxation if relaxed
+void RegLpInfo::glp_mipSolve(bool relaxed) {
+	glp_prob* glp = glpprob->glp;
+	RegMipStats& stats = glpprob->stats;
+
 	//control parameters for mip solver
 	glp_iocp iparm;
 	glp_init_iocp(&iparm);
@@ -721,6 +1033,37 @@ void RegLpInfo::glp_solve(){
 	//iparm.tol_int=1e-2;
 	iparm.tm_lim = 60000; //milliseconds
 
+	vector<double> xinc;
+	GlpCallbackInfo cb;
+	cb.x = NULL;
+	cb.done = false;
+	cb.mip = NULL;
+	cb.itcnt = 0;
+	cb.nodes = 0;
+	cb.gap = 0;
+	// intopt starts from the optimal relaxation instead of presolving from scratch
+	if (relaxed) {
+		iparm.presolve = GLP_OFF;
+		// previous solution as incumbent of a warm-started solve
+		if (warm_start && glpprob->x.size()) {
+			vector<double> xs(numcols);
+			for (int i=0;i<numcols;i++)
+				xs[i] = ctype[i]=='I' ? floor(glpprob->x[i]+0.5) : glpprob->x[i];
+			if (glp_isFeasible(xs)) {
+				// glpk counts columns from 1
+				xinc.resize(numcols+1);
+				copy(xs.begin(), xs.end(), xinc.begin()+1);
+				cb.x = &xinc[0];
+			}
+		}
+	}
+	// the callback is only installed when it has something to do
+	if (cb.x || g->MIP_LOG) {
+		iparm.cb_func = glp_callback;
+		iparm.cb_info = &cb;
+	}
+
+	int itcnt = glp_iterations(glp);
 	// solving mip
     int statt=glp_intopt(glp, &iparm);
 	if (statt) {
@@ -729,30 +1072,75 @@ void RegLpInfo::glp_solve(){
 
 	stat = glp_mip_status(glp);
 	objval = glp_mip_obj_val(glp);
-/*	if (stat!=GLP_OPT) 
-		debug("gdebug2.txt");
-//*/
 
 	// retrive activity levels...
     for (int i=0; i<numcols; i++) {
         double temp= glp_mip_col_val(glp, i+1);
         x[i]=temp;
     }
+	// without a solution GLPK still reports the one of the previous solve
+	// of the problem; a problem built for this solve only has zeros there
+	if (stat != GLP_OPT && stat != GLP_FEAS) {
+		objval = 0;
+		fill(x.begin(), x.end(), 0.0);
+	}
 
-	glp_delete_prob(glp);
-	return ;
+	// iterations on glp (all without presolve) and on the presolved copy
+	stats.iterations += glp_iterations(glp) - itcnt;
+	if (cb.mip && cb.mip != glp) {
+		stats.iterations += cb.itcnt;
+		stats.rows_removed = glp_get_num_rows(glp) - glp_get_num_rows(cb.mip);
+		stats.cols_removed = glp_get_num_cols(glp) - glp_get_num_cols(cb.mip);
+	}
+	stats.nodes = cb.nodes;
+	stats.gap = stat == GLP_OPT ? 0 : cb.gap;
 }
 
-#undef MAX_NUM
+void RegLpInfo::glp_solve(){
+	chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+	{
+		lock_guard<mutex> lock(glpk_mutex);
+		if (!glpprob)
+			glp_build();
+		else
+			glp_update();
+
+		RegMipStats& stats = glpprob->stats;
+		stats = RegMipStats();
+		int itcnt = glp_iterations(glpprob->glp);
+		bool relaxed = (warm_start || g->LP_RELAXATION_FIRST) && glp_relax();
+		stats.iterations = glp_iterations(glpprob->glp) - itcnt;
+		// the rounded relaxation is only taken if it keeps all rows and bounds
+		bool done = false;
+		if (relaxed && g->LP_RELAXATION_FIRST && glp_isIntegral()) {
+			glp_lpSolution();
+			done = glp_isFeasible(x);
+		}
+		// only a warm start goes on from the relaxation, otherwise the
+		// branch and bound presolves as without LP_RELAXATION_FIRST
+		if (!done)
+			glp_mipSolve(relaxed && warm_start);
+	}
+	if (g->MIP_LOG)
+		logSolve(false, chrono::duration<double>(chrono::steady_clock::now()-t0).count());
+
+	if (stat == GLP_OPT || stat == GLP_FEAS)
+		glpprob->x = x;
+	else
+		glpprob->x.clear();
+	return ;
+}
 #endif
 
 RegLinkObject* RegLpInfo::mklink(onelink& lk, int dn, int dk) {
+    const map <string, int>& marketId = g->inputs->marketId;
+    const map <string, int>& investId = g->inputs->investId;
     int vk;
     string skString= lk.linktype;
     std::transform(skString.begin(), skString.end(), skString.begin(),
                (int(*)(int)) std::toupper);
     if (skString=="MARKET") {
-		int sn = marketId[lk.numbertype];
+		int sn = indexOf(marketId, lk.numbertype);
         string vkString= lk.valuetype;
         std::transform(vkString.begin(), vkString.end(), vkString.begin(),
                (int(*)(int)) std::toupper);
@@ -775,7 +1163,7 @@ RegLinkObject* RegLpInfo::mklink(onelink& lk, int dn, int dk) {
         if (dk == 1) //capacity links
            sn = atoi(lk.numbertype.c_str());
         else {
-			sn = investId[lk.numbertype];
+			sn = indexOf(investId, lk.numbertype);
 		}
 		string vkString= lk.valuetype;
         std::transform(vkString.begin(), vkString.end(), vkString.begin(),
@@ -885,7 +1273,7 @@ RegLinkObject* RegLpInfo::mklink(onelink& lk, int dn, int dk) {
 		string vkString= lk.valuetype;
 		std::transform(vkString.begin(), vkString.end(), vkString.begin(),
                (int(*)(int)) std::toupper);
-        int sn = marketId[lk.numbertype];
+        int sn = indexOf(marketId, lk.numbertype);
 
 		if (vkString=="SY")
             vk=0;
@@ -909,7 +1297,10 @@ RegLinkObject* RegLpInfo::mklink(onelink& lk, int dn, int dk) {
     return NULL;
 }
 
-void RegLpInfo::stdMatLink() {
+void RegLpInfo::stdMatLink(const map <pair<int, int>, bool>& linkmat) {
+    const struct matrixdata& matrixdata = g->inputs->matrixdata;
+    const map <string, int>& colindex = g->inputs->colindex;
+    const map <string, int>& investId = g->inputs->investId;
     int dk = 0; //matrix link
     onelink lk;
     for (int i=0; i<2; i++) {   //0 liquidity 1 financing_rule
@@ -932,8 +1323,8 @@ void RegLpInfo::stdMatLink() {
         }
 		//*/
         int sz = matrixdata.colnames.size();
-        int hli = colindex["HIREDLAB"];
-        int ofli = colindex["OFFFARMLAB"];
+        int hli = indexOf(colindex, "HIREDLAB");
+        int ofli = indexOf(colindex, "OFFFARMLAB");
         for (int j = 0 ; j< sz ; j++) {
             // must be an invest
             if  (investId.find(matrixdata.colnames[j])==investId.end()){
@@ -956,7 +1347,10 @@ void RegLpInfo::stdMatLink() {
     return;
 }
 
-void RegLpInfo::stdObjLink() {
+void RegLpInfo::stdObjLink(const map <int, bool>& linkobj) {
+    const struct matrixdata& matrixdata = g->inputs->matrixdata;
+    const map <string, int>& marketId = g->inputs->marketId;
+    const map <string, int>& investId = g->inputs->investId;
     int dk=2 ; //obj link
     int dn;
     onelink lk;
@@ -987,12 +1381,17 @@ void RegLpInfo::stdObjLink() {
 
 RegLinkObject*
 RegLpInfo::readLink(int dn,int dk) {
+    const struct caplinkdata& caplinkdata = g->inputs->caplinkdata;
+    const struct objlinkdata& objlinkdata = g->inputs->objlinkdata;
+    const struct matlinkdata& matlinkdata = g->inputs->matlinkdata;
+    const map <string, int>& colindex = g->inputs->colindex;
+    const map <string, int>& rowindex = g->inputs->rowindex;
     onelink lk;
     int r, c;
     switch (dk) {
     case 0:     //matrixlink
-                r = rowindex[matlinkdata.matlinks[dn].row];
-                c = colindex[matlinkdata.matlinks[dn].col];
+                r = indexOf(rowindex, matlinkdata.matlinks[dn].row);
+                c = indexOf(colindex, matlinkdata.matlinks[dn].col);
                 lk.linktype=matlinkdata.matlinks[dn].linktype;
                 lk.numbertype=matlinkdata.matlinks[dn].col;// numbertype;
                 lk.valuetype=matlinkdata.matlinks[dn].valuetype;
@@ -1005,7 +1404,7 @@ RegLpInfo::readLink(int dn,int dk) {
     case 2:     // obj. func. link
                 lk= objlinkdata.objlinks[dn];
 				//lk.numbertype=lk.name;
-                dn = colindex[lk.name];
+                dn = indexOf(colindex, lk.name);
                 break;
     default: ;
     }
@@ -1139,10 +1538,11 @@ RegLpInfo::clone(RegGlobalsInfo* G) {
     (*n).numcols=numcols;
     (*n).numrows=numrows;
     (*n).prodcols=prodcols;
-    (*n).mat_val.resize(numcols*numrows);
+    (*n).mat_val = mat_val;
+    (*n).mat_ind = mat_ind;
+    (*n).mat_beg = mat_beg;
+    (*n).mat_xslots = mat_xslots;
     (*n).nzspace=nzspace;
-    for (int i = 0; i < numcols*numrows; i++)
-        (*n).mat_val[i] = mat_val[i];
     (*n).rhs.resize(numrows);         // capacity values
     (*n).obj.resize(numcols);         // array with objective function coefficients
     (*n).sense.resize(numrows);         // array containing the sense of each constraint
@@ -1358,14 +1758,15 @@ RegLpInfo::initLinks(RegFarmInfo*f,
             break;
         }
     }
+    link_table.build(invest_links,market_links,reference_links,number_links);
 }
 
 double
 RegLpInfo::LpWithPrice(RegProductList* PList, vector<int >& ninv, int maxofffarmlu) {
     bool prod = false;
     if (PList->setUsePriceExpectation(false)) { // hier war der Fehler
-        for (unsigned i=0;i<market_links.size();i++)
-            market_links[i]->trigger();
+        if (link_table.syncMarket(&(*mat_val.begin()),&(*rhs.begin()),&(*obj.begin())))
+            coefs_changed=true;
     }
     return Lp(PList,ninv,prod,maxofffarmlu);
 }
@@ -1373,8 +1774,8 @@ double // LP for investment and other LPs
 RegLpInfo::LpWithPriceExpectation(RegProductList* PList, vector<int >& ninv, int maxofffarmlu) {
     bool prod = false;
     if (PList->setUsePriceExpectation(true)) { // hier war der Fehler
-        for (unsigned i=0;i<market_links.size();i++)
-            market_links[i]->trigger();
+        if (link_table.syncMarket(&(*mat_val.begin()),&(*rhs.begin()),&(*obj.begin())))
+            coefs_changed=true;
     }
     return Lp(PList,ninv, prod, maxofffarmlu);
 }
@@ -1382,8 +1783,8 @@ double  // LP for production
 RegLpInfo::LpProdPriceExpectation(RegProductList* PList, vector<int >& ninv, int maxofffarmlu) {
     bool prod = true;
     if (PList->setUsePriceExpectation(true)) { // hier war der Fehler
-        for (unsigned i=0;i<market_links.size();i++)
-            market_links[i]->trigger();
+        if (link_table.syncMarket(&(*mat_val.begin()),&(*rhs.begin()),&(*obj.begin())))
+            coefs_changed=true;
     }
     return Lp(PList,ninv, prod,maxofffarmlu);
 }
@@ -1391,13 +1792,29 @@ RegLpInfo::LpProdPriceExpectation(RegProductList* PList, vector<int >& ninv, int
 bool
 RegLpInfo::changeMatrix(int nel ,int* indexRow, int* indexCol, double* val) {
     for (int i=0;i<nel;i++) {
-        int index=numrows*indexCol[i]+indexRow[i];
-        if (mat_val[index]==0 && val[i]!=0)
+        int index=getSlot(indexRow[i],indexCol[i]);
+        double old= index<0 ? 0 : mat_val[index];
+        if (old==0 && val[i]!=0)
             nzspace--;
-        if (mat_val[index]!=0 && val[i]==0)
+        if (old!=0 && val[i]==0)
             nzspace++;
-        mat_val[index]=val[i];
-    }
+        if (index<0) {
+            if (val[i]==0)
+                continue;
+            // new cell: appended so that the slots of the links stay valid
+            const double* old_val=mat_val.data();
+            mat_xslots[indexCol[i]].push_back(mat_val.size());
+            mat_ind.push_back(indexRow[i]);
+            mat_val.push_back(val[i]);
+            // the links point into mat_val
+            if (mat_val.data()!=old_val)
+                pointMatLinks();
+        } else
+            mat_val[index]=val[i];
+    }
+    // cells of links may have been overwritten
+    link_table.invalidate();
+    coefs_changed=true;
     return true;
 }
 
@@ -1407,6 +1824,81 @@ RegLpInfo::setCellValue(int c,int r,double val) {
     changeMatrix(1,&r,&c,&val);
 }
 
+double
+RegLpInfo::getCellValue(int c,int r) {
+    int index=getSlot(r,c);
+    return index<0 ? 0 : mat_val[index];
+}
+
+int
+RegLpInfo::getSlot(int row, int col) {
+    vector<int>::iterator b=mat_ind.begin()+mat_beg[col];
+    vector<int>::iterator e=mat_ind.begin()+mat_beg[col+1];
+    vector<int>::iterator it=lower_bound(b,e,row);
+    if (it!=e && *it==row)
+        return it-mat_ind.begin();
+    const vector<int>& xs=mat_xslots[col];
+    for (unsigned int i=0;i<xs.size();i++)
+        if (mat_ind[xs[i]]==row)
+            return xs[i];
+    return -1;
+}
+
+int
+RegLpInfo::getMatColumn(int col, int* ind, double* val) {
+    int len=0;
+    for (int s=mat_beg[col];s<mat_beg[col+1];s++) {
+        if (mat_val[s]!=0) {
+            ++len;
+            ind[len]=mat_ind[s]+1;
+            val[len]=mat_val[s];
+        }
+    }
+    bool added=false;
+    const vector<int>& xs=mat_xslots[col];
+    for (unsigned int i=0;i<xs.size();i++) {
+        int s=xs[i];
+        if (mat_val[s]!=0) {
+            ++len;
+            ind[len]=mat_ind[s]+1;
+            val[len]=mat_val[s];
+            added=true;
+        }
+    }
+    // keep the rows ascending as in the dense layout
+    if (added) {
+        for (int i=2;i<=len;i++) {
+            for (int j=i;j>1 && ind[j-1]>ind[j];j--) {
+                swap(ind[j-1],ind[j]);
+                swap(val[j-1],val[j]);
+            }
+        }
+    }
+    return len;
+}
+
+vector<RegLinkObject*>
+RegLpInfo::getAllLinks() {
+    vector<RegLinkObject*> links;
+    links.insert(links.end(),invest_links.begin(),invest_links.end());
+    links.insert(links.end(),market_links.begin(),market_links.end());
+    links.insert(links.end(),reference_links.begin(),reference_links.end());
+    links.insert(links.end(),number_links.begin(),number_links.end());
+    links.insert(links.end(),land_links.begin(),land_links.end());
+    links.insert(links.end(),yield_links.begin(),yield_links.end());
+    return links;
+}
+
+void
+RegLpInfo::pointMatLinks() {
+    if (mat_val.empty())
+        return;
+    vector<RegLinkObject*> links=getAllLinks();
+    for (unsigned int i=0;i<links.size();i++)
+        if (links[i]->getDestKind()==0)
+            links[i]->setDest(&(*mat_val.begin()));
+}
+
 void
 RegLpInfo::setSenseLessEqual(int row) {
     if (row>=0 && row < numrows) {
@@ -1439,7 +1931,7 @@ RegLpInfo::setUBoundInf(int col) {
 }
 
 void RegLpInfo::setUBound(int col, int val){
-    if (col<numcols) {
+    if (col>=0 && col<numcols) {
         ub[col] = val;
 	}
 }
@@ -1466,6 +1958,8 @@ RegLpInfo::restore() {
     RegLpInfo* tmp=obj_backup;
     *this=*obj_backup;
     obj_backup=tmp;
+    coefs_changed=true;
+    pointMatLinks();
 }
 
 #ifndef FRONTMIPISINSTALLED
@@ -1474,8 +1968,10 @@ double
 RegLpInfo::LpGlpk(RegProductList* PList, vector<int >& ninv, bool prod, int maxofffarmlu ) {
     LPX *lpglpk;
     // ia[] -> rows; ja[]->columns;
-    int ia[1+10000], ja[1+10000];  // nzspace must be lower than 10000
-    double ar[1+10000]; //array of the coefficients
+    vector<int> ia(1+mat_val.size()), ja(1+mat_val.size());
+    vector<double> ar(1+mat_val.size()); //array of the coefficients
+    vector<int> ind(1+numrows);
+    vector<double> val(1+numrows);
     double Z; //  objective variable
 
 
@@ -1505,23 +2001,19 @@ RegLpInfo::LpGlpk(RegProductList* PList, vector<int >& ninv, bool prod, int maxo
 
     // creating the three arrays needed for lpx_load_matrix(): rows, column, value
     // zero coefficients are not allowed
-    int matrix_counter=1;
     int nz_counter=1;
     for (int j=1;j<numcols+1;j++) {
-        for (int i=1;i<numrows+1;i++) {
-            if (mat_val[matrix_counter-1] != 0) {
-                ia[nz_counter] = i;
-                ja[nz_counter] = j;
-                ar[nz_counter] = mat_val[matrix_counter-1];
-                nz_counter++;
-                if (nz_counter>=10000) throw 1; // exeption made if the matrix has more non-zero coefficients than the one declared
-            }
-            matrix_counter++;
+        int len=getMatColumn(j-1,&ind[0],&val[0]);
+        for (int k=1;k<=len;k++) {
+            ia[nz_counter] = ind[k];
+            ja[nz_counter] = j;
+            ar[nz_counter] = val[k];
+            nz_counter++;
         }
     }
 
 // loading the constrain coefficient matrix..
-    lpx_load_matrix(lpglpk, nz_counter-1, ia, ja, ar);
+    lpx_load_matrix(lpglpk, nz_counter-1, &ia[0], &ja[0], &ar[0]);
 // solving the problem with only continuous variables..
     lpx_simplex(lpglpk);
 
@@ -1670,16 +2162,15 @@ RegLpInfo::globalAllocation(list<RegFarmInfo*>& farms,RegRegionInfo* region, int
         (*iter)->getObjective();
         }
 
-        int mc=0;
         for (int i=0;i<(*iter)->lp->numcols;i++) {
             ia[col]=c;
             for (int j=0;j<(*iter)->lp->numrows;j++) {
-                if ((*iter)->lp->mat_val[mc]!=0) {
+                double v=(*iter)->lp->getCellValue(i,j);
+                if (v!=0) {
                     ja[c]=j+k*(*iter)->lp->numrows;
-                    ar[c]=(*iter)->lp->mat_val[mc];
+                    ar[c]=v;
                     c++;
                 }
-                mc++;
             }
             col++;
         }
@@ -21,6 +21,7 @@
 #include "solverwahl.h"
 
 #include <vector>
+#include <memory>
 #include <stdlib.h>
 #include <fstream>
 #include "RegGlobals.h"
@@ -28,6 +29,7 @@
 #include "RegStructure.h"
 #include "RegInvest.h"
 #include "RegLink.h"
+#include "RegLinkTable.h"
 
 #include "textinput.h"
 
@@ -47,11 +49,34 @@ extern "C" {
     #include "glpk.h"
 }
 #endif
+#include "RegMipLog.h"
 
 #include "RegLabour.h"
 
 //---------------------------------------------------------------------------
 
+#ifdef GNU_SOLVER
+/** RegGlpProblem: the GLPK problem of one farm LP, kept alive between
+    solves together with the values last loaded into it. Only entries
+    that differ from these are passed to GLPK before the next solve.
+*/
+struct RegGlpProblem {
+    glp_prob* glp;
+    vector<double> rhs;
+    vector<char> sense;
+    vector<double> obj;
+    vector<double> lb;
+    vector<double> ub;
+    vector<double> mat_val;
+    /// last integer solution, offered as incumbent to warm-started solves
+    vector<double> x;
+    /// work of the last solve, all of it only with MIP_LOG
+    RegMipStats stats;
+    RegGlpProblem() : glp(NULL) {}
+    ~RegGlpProblem();
+};
+#endif
+
 /** RegLpInfo class.
     @short class that defines the Lp routine and all functions to manage
     the Lp matrix, constraints, etc.
@@ -84,10 +109,29 @@ protected:
 	void updateBoundsYoungFarmer();
 
     bool flat_copy;
+    /// set when a link trigger or changeMatrix altered a coefficient since the last solve
+    bool coefs_changed;
     /// pointer to globals
     RegGlobalsInfo* g;
-    // non-zero coefficient value, size nzspace
+    /** constraint matrix in compressed sparse column form. mat_val has one
+        slot for each structural non-zero and each cell written by a matrix
+        link, mat_ind the row of a slot, mat_beg the first slot of a column.
+        Cells without a slot that are set later by changeMatrix are appended
+        after mat_beg[numcols]; mat_xslots[col] keeps the appended slots of
+        column col.
+    */
     vector<double> mat_val;
+    vector<int> mat_ind;
+    vector<int> mat_beg;
+    vector< vector<int> > mat_xslots;
+    /// slot of cell (row,col), -1 if it has none
+    int getSlot(int row, int col);
+    /// non-zeros of column col in ind[1..len], val[1..len] sorted by row
+    int getMatColumn(int col, int* ind, double* val);
+    /// all link objects, each once
+    vector<RegLinkObject*> getAllLinks();
+    /// points the matrix links to the slot array
+    void pointMatLinks();
     // status of the solution
     long     stat;
     // objective function value
@@ -144,6 +188,8 @@ protected:
     vector<RegLinkObject *> obj_links;
     //
     vector<RegLinkObject *> incomepay_links;
+    /// market, invest, reference and number links as used by updateLpValues
+    RegLinkTable link_table;
     /** method that connects sources to destinations in the MIP
         values are retrieved from the input file and written at
         the appropriate position in the MIP
@@ -157,13 +203,42 @@ protected:
 
 
     //standardwerte fr die Links
-    void stdMatLink() ;
-    void stdObjLink() ;
+    void stdMatLink(const map <pair<int, int>, bool>& linkmat) ;
+    void stdObjLink(const map <int, bool>& linkobj) ;
 
     //gemeinsames 
     RegLinkObject* mklink(onelink& lk, int dn, int dk);
 
     RegLpInfo* obj_backup;
+
+#ifdef GNU_SOLVER
+    /** persistent GLPK problem; shared by flat copies (backup), a deep
+        copy (clone(G)) starts without one */
+    shared_ptr<RegGlpProblem> glpprob;
+    void glp_setRowBnds(int i);
+    void glp_setColBnds(int i);
+    void glp_build();
+    void glp_update();
+    void glp_loadMatrix();
+    /// simplex from the previous basis, true if the relaxation is optimal
+    bool glp_relax();
+    bool glp_isIntegral();
+    void glp_lpSolution();
+    void glp_mipSolve(bool relaxed);
+    void glp_solve();
+    void glp_cachedSolve();
+    /// canonical byte image of the problem, key of the MIP cache
+    string mipKey();
+    /// hash of mipKey() without building the image
+    uint64_t mipHash();
+    /// passes the pieces of mipKey() to put
+    template<class Put> void mipImage(Put& put);
+    bool glp_isFeasible(const vector<double>& xs);
+    /// adds the last solve to the MIP log of the simulation
+    void logSolve(bool cached, double time);
+#endif
+    /// solve from the previous basis and offer the previous solution
+    bool warm_start;
 public:
     /// Modify right hand side
         string printVar(double val, int no);
@@ -180,8 +255,10 @@ public:
 	void setLBoundZero(int col);
 	void setLBound(int col, int val);
 
+	/// column or row of a name in the matrix file, -1 if there is none
 	int getColIndex(string);
 	int getRowIndex(string);
+	/// value of column id in the last solution, 0 for id -1
 	double getValOfIndex(int);
 
     /** Lp optimisation method
@@ -200,7 +277,6 @@ public:
 #ifdef GNU_SOLVER //ndef FRONTMIPISINSTALLED
     /** Lp optimization method using glpk library */
     double  LpGlpk(RegProductList* PList,vector<int >& ninv, bool prod, int famlabour);
-    void glp_solve();
 #endif
     /** \begin{itemize}
             \item read in an assign values to variables
@@ -212,17 +288,19 @@ public:
     void    setupMatrix(RegGlobalsInfo* G);
     /** Because variables affecting the MIP problem change during
         runtime, this method updates these values. The respective
-        actual values are retrieved
+        actual values are retrieved by link_table
         \begin{itemize}
-            \item invest_links->trigger() updates all values which are affected
-                    by changed investment data
-            \item market_links->trigger() updates all values affected by changed
-                    market data (e.g. prices)
-            \item reference_links->trigger() updates all references to specific
+            \item invest links update all values which are affected
+                    by changed investment data, capacities only when the
+                    invest list changed
+            \item market links update all values affected by changed
+                    market data (e.g. prices), var costs only when the
+                    product list changed
+            \item reference links update all references to specific
                     variables @see market_links
-            \item number_links->trigger() always retrieves 0 as a value because
-                    the values behind number links are not influenced
-                    by changes in other classes or variables
+            \item number links are written only after the table was
+                    invalidated because the values behind number links are
+                    not influenced by changes in other classes or variables
         \end{itemize}
     */
     bool    updateLpValues();
@@ -249,6 +327,7 @@ public:
     double LpProdPriceExpectation(RegProductList* PList, vector<int >& ninv, int maxofffarmlu);
     bool changeMatrix(int nel ,int* indexRow, int* indexCol, double* dels);
     void setCellValue(int c,int r,double val);
+    double getCellValue(int c,int r);
     /// Constructor
     double globalAllocation(list<RegFarmInfo*>& farms, RegRegionInfo* region, int iteration);
     void globalAllocationFromFile(list<RegFarmInfo*>& farms, RegRegionInfo* region,string file);
@@ -260,6 +339,9 @@ public:
     void setFlatCopy() {
         flat_copy=true;
     }
+    void setWarmStart(bool w) {
+        warm_start=w;
+    }
     /// Destructor
     ~RegLpInfo();
 };
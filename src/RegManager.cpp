@@ -36,31 +36,6 @@
 #include "random.h"
 
 using namespace std;
-map<int,int> manageCoeffMap;
-map<int, int> betaMap;
-
-long int mtRandMin = 0 ;
-long int mtRandMax= 0x7FFFFFFFUL ;
-
- struct farmsdata farmsdata  ;
- map <string, farminvestdata > farmsIinvest;
-
- struct globdata globdata;
- struct transdata transdata  ;
- struct matrixdata matrixdata  ;
- struct matrixdata_n matrixdata_n  ;
- struct matrixdata_new matrixdata_new  ;
-
- struct objlinkdata objlinkdata   ;
- struct caplinkdata caplinkdata   ;
- struct matlinkdata   matlinkdata   ;
-
- struct envmarketdata  envmarketdata    ;
- struct investdata investdata     ;
- struct marketdata marketdata    ;
- struct envdata  envdata       ;
-
- vector <oneyield> yielddata;
 
 //soil service 
 void RegManagerInfo::UpdateSoilserviceP(){
@@ -110,7 +85,7 @@ RegManagerInfo::RegManagerInfo(RegGlobalsInfo* G)
     // thread priority
     iteration = 0;
     evaluator= new Evaluator("policy_switching");
-    randInit(g->SEED);
+    g->mtrand.randInit(g->SEED);
 }
 
 RegManagerInfo*
@@ -198,8 +173,9 @@ void RegManagerInfo::init() {
     f=t=n=0;
     Policyoutput = new OutputControl(g);
 
-	readfiles(g->INPUTFILEdir.c_str(), g->HAS_SOILSERVICE);
-	randInit(g->SEED);
+	if (!g->INPUT_READ)
+		g->readInputs();
+	g->mtrand.randInit(g->SEED);
  
 	// create market and pass globals
     Market = new RegMarketInfo(g);
@@ -231,7 +207,6 @@ void RegManagerInfo::init() {
 
     // investmen objects create themselves and are stored in InvestCatalog vector
     initInvestmentCatalog();
-    initMatrix0();
     initMatrix();
 
     setPremiumColRow();
@@ -266,7 +241,7 @@ void RegManagerInfo::testLivestockInvRand() {
 	for (int t = 100; t < 1000000; t*=10) {
 		int num = 0;
 		for (int x = 0; x < t; ++x) {
-			if (g->getRandomReal("LIVESTOCK_INV", g->uni_real_distrib_livestock_inv) < 0.1)
+			if (g->getRandomReal(RAND_GEN::LIVESTOCK_INV, g->uni_real_distrib_livestock_inv) < 0.1)
 				++num;
 		}
 		printf("%d\t of \t%d\n", num, t);
@@ -293,7 +268,7 @@ RegManagerInfo::initGlobals(bool read=true) {
 }
 
 void RegManagerInfo::initCommandlineOptions() {
-	map<int*, int> ops = g->options;
+	vector<pair<int RegGlobalsInfo::*, int> > ops = g->options;
 	for (auto item:ops) 	{
 		g->setOption(item.first, item.second);
 	}
@@ -311,6 +286,8 @@ void RegManagerInfo::setIncreasePrices(){
 
 void
 RegManagerInfo::initGlobals2() {
+    const struct investdata& investdata = g->inputs->investdata;
+    const struct marketdata& marketdata = g->inputs->marketdata;
   // nummber fr globals nachhole
     map <string,int> prodId;
     map <string, int> invId;
@@ -408,359 +385,6 @@ static string trim(const std::string& str, const std::string& whitespace = " ")
 }
 
 
-double getFactor(string str){
-    string tstr = trim(str," ()");
-    double d = stod(tstr); 
-    
-    return d;
-}
-
-vector<double> getFactorList(string str) {
-    vector<double> vec;
-	string tstr = trim(str, " {}");
-	regex sep("[, ()]+");
-	auto it = sregex_token_iterator(tstr.begin(),tstr.end(), sep,-1);
-	sregex_token_iterator tend;
-    for(;it!=tend;++it) {
-		string astr = (*it);
-		if (astr.length()==0) continue;
-		vec.push_back(getFactor(astr));
-	}
-    return vec;
-}
-
-vector<string> getVarNames(map<string,int> m, string str){
-  vector<string> avec;
-  string str1, str2;
-  smatch sm;
-  if (!regex_search(str,sm,regex("=>"))) {
-	  cout << "=> not found in the name range.\n";
-	  exit(5);
-  }
-  str1 = trim(sm.prefix(),"{ ");
-  str2 = trim (sm.suffix(), "} ");
-      
-  if (m.find(str1)!=m.end() && m.find(str2)!=m.end()) {
-       for (int i=m[str1]; i<=m[str2]; ++i) {
-			avec.push_back(matrixdata.colnames[i]);
-	    }
-  }
-  return move(avec);
-}
-
-pair<string,double> getTerm(string str, string name){
-    auto pos1 = str.find_first_of('.', 0); 
-    string fname = str.substr(0,pos1);
-    string cname = str.substr(pos1+1, str.size()-1-pos1);
-    double val;
-    if (!fname.compare("market")) {
-		auto prod = marketdata.products;
-        auto ap = prod[0];
-        for (auto &p: prod) {
-            if (!name.compare(p.name)) {
-                ap = p;
-                break;
-			}
-		}
-        if (!cname.compare("labour")) {
-			val = ap.labour;
-		}else if (!cname.compare("initPrem")) {
-			val = ap.initprem;
-		}else {
-            cout << "not implemented yet.\n";
-            exit(5);
-		}
-	}else if (!fname.compare("investments")) {
-		auto inv = investdata.invests;
-        auto ai = inv[0];
-		for (auto &v:inv){
-			if (!name.compare(v.name)) {
-                ai = v;
-                break;
-	    	}
-		}
-        if (!cname.compare("labSub")){
-            val = ai.labsub;
-		}else if (!cname.compare("capacity")){
-			val = ai.capacity;
-		}else {
-            cout << "not yet implemented. \n";
-            exit(5);
-		}
-	}
-	else {
-		cout << "not implemented yet. \n";
-        exit(5);
-	}
-    return make_pair(name,val);
-}
-
-vector<pair<string,double>> getTerms(string text, string namerange=""){
-    vector<pair<string,double>> terms;
-    
-    auto pos1 = text.find_first_of('.', 0); 
-    auto pos2 = text.find_first_of('.', pos1+1);
-    string fname = text.substr(0,pos1);
-    string cname = text.substr(pos1+1, pos2-pos1-1);
-
-	bool totake = false;
-    bool tocheck = false;
-
-	if (namerange.length()==0) {
-		totake = true;
-	}
-
-	string nam1, nam2;
-	smatch sm;
-	if (!totake){
-	  tocheck = true;
-	  if (regex_search(namerange, sm, regex("=>"))) {
-		nam1 = trim(sm.prefix(),"{ ");
-		nam2 = trim(sm.suffix(), "} ");
-	  }else {
-		cout << "not a valid range of variables. \n";
-		exit (5);
-	  }
-	}
-
-	bool over = false;
-    string astr;
-    double aval;
-    if (!fname.compare("market")) {
-        //norange
-        for (auto &x: marketdata.products) {
-			if (over) break;
-			if (!totake) {
-				if ((x.name).compare(nam1)) continue;
-				else totake  = true;
-			}
-			if (totake) {
-              astr = x.name;
-              if (!cname.compare("labour")) {
-                  aval = x.labour;
-			  }else if (!cname.compare("initPrem")){
-				  aval = x.initprem;
-			  }else {
-                  cout << "not implemented yet. \n";
-                  exit(5);
-			  }
-			  if (tocheck) {
-		      if (!((x.name).compare(nam2))) 
-				  over = true;
-			  }
-			}
-			terms.push_back(make_pair(astr,aval));
-		}
-	}else if(!fname.compare("investments")) {
-        
-		for (auto &x: investdata.invests){
-			if(over) break;
-			if (!totake) {
-				if (!((x.name).compare(nam1))) {
-					totake = true;
-				}
-			}
-			if (totake) {
-              astr = x.name;
-              if (!cname.compare("labSub")){
-				 aval = x.labsub;
-			  }else if (!cname.compare("capacity")){
-                  aval = x.capacity;
-			  }else {
-                  cout << "not yet implemented.\n";
-                  exit(5);
-			  }
-			  if (tocheck) {
-			    if (!((x.name).compare(nam2))) {
-				  over = true;
-			    }
-			  }
-			  terms.push_back(make_pair(astr,aval));
-			}
-		}
-	}else {
-        cout << " I dont know where to find the data from " << fname << endl;
-        exit(5);
-	}
-
-    return move(terms);
-}
-
-// initialise MIP matrix
-void RegManagerInfo::initMatrix0(){
-    int ind=0;
-    map<string,int> colInd;
-	for (auto &x:matrixdata_n.VarNames0) {
-        if (!trim(x).compare("market.name._all_")) {
-			for( auto ap: marketdata.products){
-				matrixdata.colnames.push_back(ap.name);
-                colInd[ap.name]=ind++;
-			}
-		}else if(!trim(x).compare("investments.name._all_")) {
-			for (auto ai: investdata.invests){
-				matrixdata.colnames.push_back(ai.name);
-                colInd[ai.name]=ind++;
-			}
-		}else {
-			matrixdata.colnames.push_back(trim(x));
-            colInd[trim(x)]=ind++;
-		}
-	}
-
-    set<string> intSet;
-	for (auto &ii: matrixdata_n.IntVars0) {
-        if (ii.find("=>")!=std::string::npos) {
-            smatch sm;
-            regex_search(ii, sm, regex("=>"));
-			string nam1=trim(sm.prefix(),"{ ");
-			string nam2=trim(sm.suffix(),"} ");
-            if (colInd.find(nam1)!=colInd.end() && colInd.find(nam2)!=colInd.end()) {
-                for (int i=colInd[nam1]; i<=colInd[nam2]; ++i) {
-                    intSet.insert(matrixdata.colnames[i]);
-				}
-			}else {
-                 cout << nam1 << " or " << nam2 << "not found as a variable name\n";
-                 exit(5);
-			}
-		}else {
-            intSet.insert(trim(ii));
-		}
-	}
-    for (auto &x: matrixdata.colnames) {
-        if ( intSet.find(x)!=intSet.end()) {
-			matrixdata.isInt.push_back(1);
-		}
-		else
-			matrixdata.isInt.push_back(0);
-	}
-
-    //rownames and mat
-    //int ri = 0;
-	for (auto &x: matrixdata_n.Restricts0) {
-		string xname=trim(x.name);
-		if (xname.length() == 0) {
-			cout << "Error : no restriction name ?\n";
-			exit(5);
-		}
-		string uname;
-		uname.resize(xname.size());
-		transform(xname.begin(), xname.end(),uname.begin(), (int (*)(int))std::toupper);
-		matrixdata.rownames.push_back(uname);
-        
-        vector<double> avec;
-		avec.resize(colInd.size(),0);
-		smatch sm;
-		string str1,str2,str3;
-		vector<string> nams;
-		vector<double> vals;
-		vector<pair<string,double>> terms;
-		for (auto &x2: x.terms0) {
-			if ((trim(x2).length()==0)) continue;
-            if (x2.find("matrixLinks")!=string::npos) continue;
-            if (x2.find("_defaultLinks_")!=string::npos) continue;
-            
-			double val;
-            vector<pair<string,double>> tms;
-            vector<string> ns;
-			regex stern("\\*");
-		    int cnt = std::distance(std::sregex_iterator(x2.begin(),x2.end(),stern),std::sregex_iterator());
-	        switch (cnt) {
-			case 0:
-				if (x2.find(".")!=string::npos ){
-                    tms = getTerms(x2);
-                    for (auto tt: tms){
-						//matrixdata.mat[ri][colInd[tt.first]] = tt.second;
-						avec[colInd[tt.first]] = tt.second;
-					}
-		        }else if (x2.find("=>")!=string::npos) {
-                    ns = getVarNames(colInd, x2);
-                    for (auto tt: ns){
-                        avec[colInd[tt]] = 1;
-						//matrixdata.mat[ri][colInd[tt]] = 1;
-					}
-				}else {
-					avec[colInd[x2]] = 1;
-					//matrixdata.mat[ri][colInd[x2]] = 1;
-				}
-                break;
-			case 1:
-				regex_search(x2,sm,regex("\\*"));
-				str1=trim(sm.prefix());
-				str2=trim(sm.suffix());
-				
-				if (str1.find("market.")!=string::npos || str1.find("investments.")!=string::npos) {
-					if (str2.find("=>")!=string::npos) {
-						terms = getTerms(str1,str2);
-						for (auto tt:terms){
-							avec[colInd[tt.first]] = tt.second;
-							//matrixdata.mat[ri][colInd[tt.first]]=tt.second;
-						}
-					}else {
-						avec[colInd[str2]] = (getTerm(str1,str2)).second;
-						//matrixdata.mat[ri][colInd[str2]] = (getTerm(str1,str2)).second;
-					}
-				}else if (str1.find("{")!=string::npos) {
-					vals = getFactorList(str1);
-					nams = getVarNames(colInd,str2);
-					int sz = vals.size();
-					for (int i=0;i<sz;++i){
-						avec[colInd[nams[i]]] = vals[i];
-						//matrixdata.mat[ri][colInd[nams[i]]] = vals[i];
-					}
-				}else {
-					val = getFactor(str1);
-					if (str2.find("=>")!=string::npos) {
-						nams = getVarNames(colInd, str2);
-						for (auto nn:nams){
-							avec[colInd[nn]] = val;
-							//matrixdata.mat[ri][colInd[nn]]=val;
-						}
-					}else if (str2.find(".")!=string::npos) {
-						terms = getTerms(str2);
-						for (auto &tt:terms){
-							avec[colInd[tt.first]] = val*tt.second;
-							//matrixdata.mat[ri][colInd[tt.first]] = val*tt.second;
-						}
-					}else {  //one Variable
-						avec[colInd[str2]] = val;
-						//matrixdata.mat[ri][colInd[str2]] = val;
-					}
-				}
-                break;
-			case 2:
-				regex_search(x2,sm,regex("(.*)\\*(.*)\\*(.*)"));
-				str1=trim(sm[1]);
-				str2=trim(sm[2]);
-				str3=trim(sm[3]);
-				
-				val = getFactor(str1);
-				if (str2.find("{")!=string::npos) {
-					vals = getFactorList(str2);
-					nams = getVarNames(colInd,str3);
-					int sz = vals.size();
-					for (int i=0;i<sz;++i){
-						avec[colInd[nams[i]]] = val*vals[i];
-						//matrixdata.mat[ri][colInd[nams[i]]] = val * vals[i];
-					}
-				}else if (str3.find("{")!=string::npos){
-					terms = getTerms(str2,str3);
-					for (auto &tt:terms){
-						avec[colInd[tt.first]] = val*tt.second;
-						//matrixdata.mat[ri][colInd[tt.first]] = val*tt.second;
-					}
-				}else { //one varialble name
-					avec[colInd[str3]] = val*(getTerm(str2,str3)).second;
-					//matrixdata.mat[ri][colInd[str3]] = val*(getTerm(str2,str3)).second;
-				}
-				break;
-			default: ;
-			}
-		}
-		matrixdata.mat.push_back(avec);
-		//++ri;
-	}
-}
-
 void
 RegManagerInfo::initMatrix() {
     Mip=createMatrix();
@@ -778,6 +402,7 @@ RegManagerInfo::initMarket() {
 
 void
 RegManagerInfo::setPremiumColRow() {
+    const struct matrixdata& matrixdata = g->inputs->matrixdata;
     //set premium row and col
     int row;
     map <string, int> colindex;
@@ -832,12 +457,14 @@ RegManagerInfo::initOutput() {
 }
 
 double RegManagerInfo::get_beta() {
-    return g->triangular("RENTVARIATION", g->Beta_min, (g->Beta_max + g->Beta_min )/2, g->Beta_max);
+    return g->triangular(RAND_GEN::RENTVARIATION, g->Beta_min, (g->Beta_max + g->Beta_min )/2, g->Beta_max);
 }
 
 // INITIALISE FARM POPULATION(S)
 void
 RegManagerInfo::initPopulations() {
+    const struct farmsdata& farmsdata = g->inputs->farmsdata;
+    const map <string, farminvestdata>& farmsIinvest = g->inputs->farmsIinvest;
      // READ INVESTMENT DATA FOR EACH FARM
 
     vector<double> initial_land_input = farmsdata.land_inputs;
@@ -850,9 +477,9 @@ RegManagerInfo::initPopulations() {
     initial_rent.resize(g->NO_OF_SOIL_TYPES);
 
     for (int j=0; j< g->NO_OF_SOIL_TYPES; j++) {
-        vector<double> oli =   farmsdata.alllands[g->NAMES_OF_SOIL_TYPES[j]].owned_land;
-        vector<double> rli =   farmsdata.alllands[g->NAMES_OF_SOIL_TYPES[j]].rented_land;
-        vector<double> ir =    farmsdata.alllands[g->NAMES_OF_SOIL_TYPES[j]].initial_rent_price;
+        vector<double> oli =   farmsdata.alllands.at(g->NAMES_OF_SOIL_TYPES[j]).owned_land;
+        vector<double> rli =   farmsdata.alllands.at(g->NAMES_OF_SOIL_TYPES[j]).rented_land;
+        vector<double> ir =    farmsdata.alllands.at(g->NAMES_OF_SOIL_TYPES[j]).initial_rent_price;
 
         owned_land_input[j]=  oli;
         rented_land_input[j]= rli;
@@ -879,17 +506,21 @@ RegManagerInfo::initPopulations() {
     }
 
     //initial investments
+    // farm types without a sheet have no initial investments
+    static const farminvestdata no_invests;
     for (int i = 0;i < g->number_of_farmtypes; i++) {
+        map <string, farminvestdata>::const_iterator fi = farmsIinvest.find(g->sheetnames[i]);
+        const farminvestdata& invests = fi!=farmsIinvest.end() ? fi->second : no_invests;
         int index=0;
         unsigned dind=0;
         for (int j=0;j<g->NUMBER_OF_INVESTS;j++) {
-            if (dind < farmsIinvest[g->sheetnames[i]].initinvests.size() ) {
-                string named =  farmsIinvest[g->sheetnames[i]].initinvests[dind].name;
+            if (dind < invests.initinvests.size() ) {
+                string named =  invests.initinvests[dind].name;
                 string namej= InvestCatalog[j].getName();
 
                 if ( named == namej ) {
-                    cap_vec[i][index] = farmsIinvest[g->sheetnames[i]].initinvests[dind].capacity;
-                    noi_vec[i][index] =  farmsIinvest[g->sheetnames[i]].initinvests[dind].quant;
+                    cap_vec[i][index] = invests.initinvests[dind].capacity;
+                    noi_vec[i][index] =  invests.initinvests[dind].quant;
                     cat_num_vec[i][index]= j;
                     dind++;
                     index++;
@@ -966,7 +597,7 @@ RegManagerInfo::initPopulations() {
             newnumber++;
 
 			if (g->RestrictInvestments) {
-				double x = g->getRandomReal("LIVESTOCK_INV", g->uni_real_distrib_livestock_inv);
+				double x = g->getRandomReal(RAND_GEN::LIVESTOCK_INV, g->uni_real_distrib_livestock_inv, newFarm->getRandomStreams());
 				if (x * 100 > g->Livestock_Inv_farmsPercent) {
 					newFarm->setAllowInvest(false);
 					//cout << "##FarmId: " << newFarm->getFarmId() << endl;
@@ -987,10 +618,20 @@ RegManagerInfo::initPopulations() {
 
 	g->REGION_MILK_QUOTA = sum_milk_quota;
 
+    // neighbouring farms follow each other, list::sort is stable
+    if (g->ZORDER_FARM_LIST) {
+        FarmList.sort([](RegFarmInfo* a, RegFarmInfo* b) {
+            RegPlotInfo* pa=a->getFarmPlot();
+            RegPlotInfo* pb=b->getFarmPlot();
+            return RegRegionInfo::zOrder(pa->getRow(),pa->getCol())
+                   < RegRegionInfo::zOrder(pb->getRow(),pb->getCol());
+        });
+    }
+
     /////////////////////////////
     // ALLOCATION OF INITIAL LAND
     /////////////////////////////
-    Region->initPlotSearch();
+    Region->initPlotSearch(FarmList);
     list<RegFarmInfo* >::iterator farms_iter;
     bool ready=false;
 
@@ -999,7 +640,7 @@ RegManagerInfo::initPopulations() {
 //if srand(g->SEED) before the loop, you get always different random ST distribution for each simulation;
 
     if (g->SOIL_TYPE_VARIATION) {
-        randInit(g->SEED);
+        g->mtrand.randInit(g->SEED);
         //srand(g->SEED);
         }
 	
@@ -1015,7 +656,7 @@ RegManagerInfo::initPopulations() {
 
     // finish up setup of region (create black plots)
     Region->finish();
-    Region->initPlotSearch();
+    Region->initPlotSearch(FarmList);
     g->INITIALISATION=false;
  
 	//init carbon
@@ -1026,8 +667,8 @@ RegManagerInfo::initPopulations() {
 			vector <double> c_mean;
 			vector <double> c_var;
 			for (int i=0;i<g->NO_OF_SOIL_TYPES;++i) {
-				c_mean.push_back(farmsdata.alllands[g->NAMES_OF_SOIL_TYPES[i]].carbon_mean[(*farms_iter)->getFarmType()]);
-				c_var.push_back(farmsdata.alllands[g->NAMES_OF_SOIL_TYPES[i]].carbon_std_dev[(*farms_iter)->getFarmType()]);
+				c_mean.push_back(farmsdata.alllands.at(g->NAMES_OF_SOIL_TYPES[i]).carbon_mean[(*farms_iter)->getFarmType()]);
+				c_var.push_back(farmsdata.alllands.at(g->NAMES_OF_SOIL_TYPES[i]).carbon_std_dev[(*farms_iter)->getFarmType()]);
 			}
 			(*farms_iter)->initCarbons(c_mean, c_var);
        }
@@ -1061,7 +702,7 @@ void RegManagerInfo::outputFarmAgeDists() {
 
 void
 RegManagerInfo::simulate() {
-    init();
+	init();
 
     while (iteration < g->RUNS) {
 		cout << "Iteration : " << iteration << "\t ( Number of Farms:  " << getNoOfFarms()<< " )"<< endl;
@@ -1071,6 +712,8 @@ RegManagerInfo::simulate() {
 		g->tPhase = SimPhase::BETWEEN;
         step();
     }
+	if (g->miplog)
+		g->miplog->writeSummary();
 	//outputFarmAgeDists();
 }
 
@@ -1362,6 +1005,7 @@ RegManagerInfo::LandAllocation() {
             if (iteration > 0) {
                 stop= true;
                 bidcount=0;
+                bid_queue.init(vector<RegFarmInfo*>(FarmList.begin(), FarmList.end()),g->NO_OF_SOIL_TYPES);
                 do { // as long as offers are positive
                     stop=true;
                     for (int i=0;i<g->NO_OF_SOIL_TYPES;i++) {
@@ -1710,7 +1354,7 @@ RegManagerInfo::Disinvest() {
 				//outputRestrictedInvs(*farms_iter);
 			}
 			else {
-				double x = g->getRandomReal("LIVESTOCK_INV", g->uni_real_distrib_livestock_inv);
+				double x = g->getRandomReal(RAND_GEN::LIVESTOCK_INV, g->uni_real_distrib_livestock_inv, (*farms_iter)->getRandomStreams());
 				//printf("%d\t %f\n", (*farms_iter)->getFarmId(), x);
 				if (x * 100 > g->Livestock_Inv_farmsPercent) {
 					(*farms_iter)->setAllowInvest(false);
@@ -1928,6 +1572,46 @@ RegManagerInfo::updateInterestDependentValues() {
         invest->setBoundEquityCapital(aec);
     }
 }
+double
+RegManagerInfo::secondOffer(RegPlotInfo* pl, RegFarmInfo* winner,
+                            vector<char>& recomputed) {
+    const vector<RegFarmInfo*>& farms=bid_queue.getFarms();
+    double second_offer=0;
+    // farms whose offer for pl is bounded by the offer for their
+    // wanted plot are only asked while they may exceed the others
+    vector<bool> exact(farms.size(),true);
+    vector<pair<double,int> > bounded;
+    for (unsigned int i=0;i<farms.size();i++) {
+        double bound;
+        if (farms[i]->boundRentOffer(pl,bound)) {
+            exact[i]=false;
+            bounded.push_back(make_pair(bound,i));
+        }
+    }
+    for (unsigned int i=0;i<farms.size();i++) {
+        if (exact[i] && farms[i]->getFarmId()!=winner->getFarmId()) {
+            bool r=false;
+            double tmp_offer=farms[i]->getRentOffer(pl,&r);
+            recomputed[i]=r;
+            if (tmp_offer>second_offer)
+                second_offer=tmp_offer;
+        }
+    }
+    sort(bounded.begin(),bounded.end(),greater<pair<double,int> >());
+    for (unsigned int k=0;k<bounded.size() && bounded[k].first>second_offer;k++) {
+        RegFarmInfo* farm=farms[bounded[k].second];
+        if (farm->getFarmId()!=winner->getFarmId()) {
+            bool r=false;
+            double tmp_offer=farm->getRentOffer(pl,&r);
+            if (r)
+                recomputed[bounded[k].second]=1;
+            if (tmp_offer>second_offer)
+                second_offer=tmp_offer;
+        }
+    }
+    return second_offer;
+}
+
 // type 0: arableLand, type 1:grassLand
 double
 RegManagerInfo::rentOnePlot(vector<int>& count_rented_plots_of_type, int type) {
@@ -1939,53 +1623,48 @@ RegManagerInfo::rentOnePlot(vector<int>& count_rented_plots_of_type, int type) {
         double true_second_offer=0;
         // list of farms with equal offer
         list<RegFarmInfo* >  equalbidder;
-        list<RegFarmInfo* >::iterator farms_iter;
         list<RegFarmInfo* >::iterator equalbidder_iter;
         list<RegFarmInfo* >::iterator  prev_owner;
 
         RegFarmInfo* maxbidder;
-        // search for the highest offer
-        for (farms_iter = FarmList.begin(), maxoffer = 0, maxbidder = NULL, equalbidder.clear();
-                farms_iter != FarmList.end();
-                farms_iter++) {
-            // determine individual rent offer for plot
-            // here,  0: arable, 1: grassland
+        const vector<RegFarmInfo*>& farms=bid_queue.getFarms();
+        // only farms whose offer may have changed since the last round are asked
+        vector<int> changed=bid_queue.changed(type);
+        // determine individual rent offer for plot
+        // here,  0: arable, 1: grassland
+        for (unsigned int k=0;k<changed.size();k++) {
+            RegFarmInfo* farm=farms[changed[k]];
 #ifndef NDEBUG1
-        g->tFarmName=(*farms_iter)->getFarmName();
-        g->tFarmId= (*farms_iter)->getFarmId();
+            g->tFarmName=farm->getFarmName();
+            g->tFarmId= farm->getFarmId();
 #endif
-            (*farms_iter)->demandForLandOfType(type,bidcount);
-            offer=(*farms_iter)-> getRentOffer();
+            farm->demandForLandOfType(type,bidcount);
+            offer=farm-> getRentOffer();
 			
 			double offer1;
 			if (g->NASG && iteration>=g->NASG_startPeriod) {
-				offer1 = NASG_RentOffer(offer, (*farms_iter), type);
+				offer1 = NASG_RentOffer(offer, farm, type);
 				if (debug)
 					cout << offer << " - " << offer1 << "\t"<< type <<endl;
 				offer = offer1;
 			}
+            bid_queue.setOffer(changed[k],type,offer,farm->getWantedPlotOfType(type));
+        }
 
-            if (offer>0) {
-
-				//if (offer/(fabs(maxoffer-offer)) < 1E-5 ) {
-                //if ((maxoffer) == offer) {
-                //    equalbidder.push_back(*farms_iter);
-                //} else {
-                    // if current offer is higher than maxoffer
-                    if ((maxoffer) < offer) {
-                        // set maxbiddr to highest bidding farm
-                        maxbidder = *farms_iter;
-                        // if there is a higher offer, the list of equal bidders
-                        // is senseless and is cleared
-                        equalbidder.clear();
-                        // the equalbidder list is filled
-                        // with new offers
-                        equalbidder.push_back(maxbidder);
-                        maxoffer = offer;
-                    }
-                //}// end else
-            }
-        }// end for
+        // search for the highest offer, of equal offers the first in FarmList
+        int maxindex=bid_queue.top(type,maxoffer);
+        maxbidder = NULL;
+        if (maxindex>=0) {
+            // set maxbiddr to highest bidding farm
+            maxbidder = farms[maxindex];
+#ifndef NDEBUG1
+            g->tFarmName=maxbidder->getFarmName();
+            g->tFarmId= maxbidder->getFarmId();
+#endif
+            // its offer is unchanged, asking again sets getRentOffer() to the offer of type
+            maxbidder->demandForLandOfType(type,bidcount);
+            equalbidder.push_back(maxbidder);
+        }
 
         // allocate land to highest bidder
 //        if (g->WEIGHTED_PLOT_SEARCH)
@@ -2002,15 +1681,14 @@ RegManagerInfo::rentOnePlot(vector<int>& count_rented_plots_of_type, int type) {
                 }
                 maxoffer=(*equalbidder_iter)->getRentOffer();
                 if(!g->FIRSTPRICE) {
-                  for (farms_iter = FarmList.begin();
-                        farms_iter != FarmList.end();
-                        farms_iter++) {
-                        if ((*farms_iter)->getFarmId()!=(*equalbidder_iter)->getFarmId()) {
-                          double tmp_offer=(*farms_iter)->getRentOffer(pl);
-                          if (tmp_offer>true_second_offer)
-                            true_second_offer=tmp_offer;
-                        }
-                  }
+                  // farms whose shadow price of type was computed for pl
+                  vector<char> recomputed(farms.size(),0);
+                  double second=secondOffer(pl,*equalbidder_iter,recomputed);
+                  if (second>true_second_offer)
+                    true_second_offer=second;
+                  for (unsigned int i=0;i<farms.size();i++)
+                        if (recomputed[i])
+                          bid_queue.invalidateOffer(i,type);
                 }
                 if (g->FIRSTPRICE) {
 
@@ -2029,6 +1707,8 @@ RegManagerInfo::rentOnePlot(vector<int>& count_rented_plots_of_type, int type) {
 				Region->updateMaxRents(offer,pl->getSoilType());
 
                 (*equalbidder_iter)->setRentedPlot(pl,offer,f_tac);
+                bid_queue.invalidateFarm(maxindex);
+                bid_queue.plotRented(pl,type);
                 if (g->Rent_Variation) {
                     pl->setSecondOffer(true_second_offer);
                 }
@@ -2126,7 +1806,7 @@ RegManagerInfo::rentOnePlot(vector<int>& count_rented_plots_of_type, int type) {
             }// end for
             // allocate land to highest bidder
             if (max_offer > 0) {
-                int w =randlong()%equalbidder.size();
+                int w =g->mtrand.randlong()%equalbidder.size();
 				
                 equalbidder_iter = equalbidder.begin();
                 for (int i=0;i<w;i++)
@@ -2528,6 +2208,7 @@ RegManagerInfo::setLpChangesFromPoliySettings() {
 }
 
 void RegManagerInfo::setLpChangesFromPoliySettingsNaming() {
+    const struct matrixdata& matrixdata = g->inputs->matrixdata;
     //go through all variables and select those how affect the farm lp's
     // the following naming convention is used
     // mat_cell:col, row=0.8;  //to set a cell in the matrix
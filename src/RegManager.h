@@ -25,6 +25,7 @@
 #include "OutputControl.h"
 #include "Evaluator.h"
 #include "RegEnvInfo.h"
+#include "RegBidQueue.h"
 /** RegManagerInfo class.
     This class is 'the brain' of the programme. It manages the all necessary
     classes and data flows.
@@ -44,7 +45,7 @@ public:
     virtual RegManagerInfo* clone(string name);
     virtual   void assign();
     /// destructor
-    ~RegManagerInfo();
+    virtual ~RegManagerInfo();
 
     RegGlobalsInfo* getGlobals() {
         return g;
@@ -73,7 +74,6 @@ public:
     void    setPremiumColRow();
     void    initPopulations();
     void    initMatrix();
-    void    initMatrix0();
     virtual RegLpInfo*    createMatrix();
 
     virtual RegFarmInfo* createFarm(RegRegionInfo * reg,
@@ -97,6 +97,10 @@ public:
     /// Simulation of one period
     virtual void step();
     void stepwhile();
+    /** init() and all periods. The input data read before is shared by
+        the simulations of the process. The MIP cache may be shared as
+        well, its statistics are left to the caller.
+    */
     void simulate();
     int getIteration() {
         return iteration;
@@ -144,10 +148,16 @@ protected:
     string current_policy;
     
     int bidcount;
+    /// offers of the old renting process, kept between the rounds
+    RegBidQueue bid_queue;
     
     /// pointer to globals
     RegGlobalsInfo* g;
 
+    /// distributions of the management coefficients and betas drawn
+    map<int,int> manageCoeffMap;
+    map<int,int> betaMap;
+
     int  iteration;
 
     // The major classes are created dynamically  because  their
@@ -305,6 +315,15 @@ protected:
         \end{itemize}
     */
     double rentOnePlot(vector<int>& count_rented_plots_of_type,int type);
+    /** second price of the old renting process: the highest offer for pl
+        of the farms other than winner. Farms whose offer is bounded by
+        the offer for their wanted plot are asked in descending order of
+        the bound, only while it exceeds the offers so far.
+        @param recomputed set to 1 for the farms whose shadow price of
+        the type of pl was computed for pl
+    */
+    double secondOffer(RegPlotInfo* pl, RegFarmInfo* winner,
+                       vector<char>& recomputed);
     void setPolicyChanges();
 
     void readPolicyChanges0();
@@ -46,6 +46,9 @@ RegMarketInfo::RegMarketInfo(const RegMarketInfo& rh,RegGlobalsInfo* G):g(G) {
 
 void
 RegMarketInfo::createMarket(RegEnvInfo* Env) {
+	const struct envmarketdata& envmarketdata = g->inputs->envmarketdata;
+	const vector <oneyield>& yielddata = g->inputs->yielddata;
+	const struct marketdata& marketdata = g->inputs->marketdata;
 	set<int> groups;
     if (marketdata.premiumName.compare("")!=0)
         g->premiumName=marketdata.premiumName;
@@ -198,7 +201,7 @@ RegMarketInfo::calculatePricevectors(RegSectorResultsInfo& Sector, int iteration
 			// price function like in Alfons original code.
 			// adjust production of sows because of pig replacement
 			if (!aname.compare("SOW")) { // sow production
-				prod[i] = (unitsproduced - Sector.getTotalUnitsProduced(g->stdNameIndexs["FATTENINGPIGS"])*g->PIGS_PER_PLACE / g->PIGLETS_PER_SOW);
+				prod[i] = (unitsproduced - Sector.getTotalUnitsProduced(g->getStdNameIndex("FATTENINGPIGS"))*g->PIGS_PER_PLACE / g->PIGLETS_PER_SOW);
 				if (prod[i] <= 0)
 					prod[i] = 1;
 			}
@@ -208,8 +211,8 @@ RegMarketInfo::calculatePricevectors(RegSectorResultsInfo& Sector, int iteration
 			
 			// MANURE MARKET
 			if (!aname.compare("MANSELL") || !aname.compare("MANBUY")) {
-				double totalmanuresold = Sector.getTotalUnitsProduced(g->stdNameIndexs["MANSELL"]);
-				double totalmanurebought = Sector.getTotalUnitsProduced(g->stdNameIndexs["MANBUY"]);
+				double totalmanuresold = Sector.getTotalUnitsProduced(g->getStdNameIndex("MANSELL"));
+				double totalmanurebought = Sector.getTotalUnitsProduced(g->getStdNameIndex("MANBUY"));
 				double excessmanure = 0;
 				double changeperha = g->CHANGEPERHA;  
 				double pricechange = 0;
@@ -217,7 +220,7 @@ RegMarketInfo::calculatePricevectors(RegSectorResultsInfo& Sector, int iteration
 				if (totallandha != 0) {
 					excessmanure = (totalmanuresold - totalmanurebought) / totallandha;
 				}
-				if (i == g->stdNameIndexs["MANSELL"]) { // sell
+				if (i == g->getStdNameIndex("MANSELL")) { // sell
 					pricechange = price_vector[i] - excessmanure * changeperha;
 				}
 				else {  //g->MANBUY
@@ -232,7 +235,7 @@ RegMarketInfo::calculatePricevectors(RegSectorResultsInfo& Sector, int iteration
 			else if (!aname.compare("GETQUOTA")) { // lease milk quota
 				double pricechange = 0;
 				// milk produced in sector
-				double totalmilk = Sector.getTotalUnitsProduced(g->stdNameIndexs["MILK"]) * g->MILKPROD;
+				double totalmilk = Sector.getTotalUnitsProduced(g->getStdNameIndex("MILK")) * g->MILKPROD;
 				pricechange = price_vector[i] * price_change_vector[i];
 				if (totalmilk > (g->MILKUPPERLIMIT * g->REGION_MILK_QUOTA)) {
 					pricechange *= g->CHANGEUP;//0.98;
@@ -246,7 +249,7 @@ RegMarketInfo::calculatePricevectors(RegSectorResultsInfo& Sector, int iteration
 			else if (!aname.compare("LETQUOTA")) { // let milk quota
 				double pricechange = 0;
 				// milk produced in sector
-				double totalmilk = Sector.getTotalUnitsProduced(g->stdNameIndexs["MILK"]) * g->MILKPROD;
+				double totalmilk = Sector.getTotalUnitsProduced(g->getStdNameIndex("MILK")) * g->MILKPROD;
 				pricechange = price_vector[i] * price_change_vector[i];
 				if (totalmilk > (g->MILKUPPERLIMIT * g->REGION_MILK_QUOTA)) {
 					pricechange *= g->CHANGEUP;//0.98;
@@ -263,7 +266,7 @@ RegMarketInfo::calculatePricevectors(RegSectorResultsInfo& Sector, int iteration
 			else if (!aname.compare("GETQUOTA_SWEDEN")) {  //i==g->GETQUOTA) { // lease milk quota
 				double pricechange = 0;
 				// milk produced in sector
-				double totalmilk = Sector.getTotalUnitsProduced(g->stdNameIndexs["MILK"]) * g->MILKPROD;
+				double totalmilk = Sector.getTotalUnitsProduced(g->getStdNameIndex("MILK")) * g->MILKPROD;
 				double excess_milk = totalmilk / g->REGION_MILK_QUOTA;
 				// Adjust milk price by rate of excess production
 				pricechange = price_vector[i] * excess_milk;
@@ -275,7 +278,7 @@ RegMarketInfo::calculatePricevectors(RegSectorResultsInfo& Sector, int iteration
 			else if (!aname.compare("LETQUOTA_SWEDEN")) {//i==g->LETQUOTA) { // let milk quota
 				double pricechange = 0;
 				// milk produced in sector
-				double totalmilk = Sector.getTotalUnitsProduced(g->stdNameIndexs["MILK"]) * g->MILKPROD;
+				double totalmilk = Sector.getTotalUnitsProduced(g->getStdNameIndex("MILK")) * g->MILKPROD;
 				double excess_milk = totalmilk / g->REGION_MILK_QUOTA;
 				// Adjust milk price by rate of excess production
 				pricechange = price_vector[i] * excess_milk;
@@ -290,8 +293,8 @@ RegMarketInfo::calculatePricevectors(RegSectorResultsInfo& Sector, int iteration
 			// but supply can be greater than demand as it is possible to export calves
 			else if (!aname.compare("SELLCALF_SUCK") || !aname.compare("BUYCALF_SUCK")) {
 				// calculate excess suckler calf demand
-				int buyind = g->stdNameIndexs["BUYCALF_SUCK"];
-				int sellind = g->stdNameIndexs["SELLCALF_SUCK"];
+				int buyind = g->getStdNameIndex("BUYCALF_SUCK");
+				int sellind = g->getStdNameIndex("SELLCALF_SUCK");
 				double excess_suck_calf = Sector.getTotalUnitsProduced(buyind) - Sector.getTotalUnitsProduced(sellind);
 				// if there is excess in supply
 				if (excess_suck_calf>0) {
@@ -310,8 +313,8 @@ RegMarketInfo::calculatePricevectors(RegSectorResultsInfo& Sector, int iteration
 			// but supply can be greater than demand as it is possible to export calves
 			else if (!aname.compare("SELLCALF_SUCK_JOENKEPING") || !aname.compare("BUYCALF_SUCK_JOENKEPING")) {
 				// calculate excess suckler calf demand
-				int buyind = g->stdNameIndexs["BUYCALF_SUCK_JOENKEPING"];
-				int sellind = g->stdNameIndexs["SELLCALF_SUCK_JOENKEPING"];
+				int buyind = g->getStdNameIndex("BUYCALF_SUCK_JOENKEPING");
+				int sellind = g->getStdNameIndex("SELLCALF_SUCK_JOENKEPING");
 				double excess_suck_calf = Sector.getTotalUnitsProduced(buyind) - Sector.getTotalUnitsProduced(sellind);
 				// if there is excess in supply
 				if (excess_suck_calf>0) {
@@ -330,8 +333,8 @@ RegMarketInfo::calculatePricevectors(RegSectorResultsInfo& Sector, int iteration
 				// calculate excess dairy calf demand
 				double  excess_dairy_calf;
 				//DCX
-				if (Sector.getTotalUnitsProduced(g->stdNameIndexs["SELLCALF_DAIRY"])>0)
-					excess_dairy_calf = Sector.getTotalUnitsProduced(g->stdNameIndexs["BUYCALF_DAIRY"]) / Sector.getTotalUnitsProduced(g->stdNameIndexs["SELLCALF_DAIRY"]);
+				if (Sector.getTotalUnitsProduced(g->getStdNameIndex("SELLCALF_DAIRY"))>0)
+					excess_dairy_calf = Sector.getTotalUnitsProduced(g->getStdNameIndex("BUYCALF_DAIRY")) / Sector.getTotalUnitsProduced(g->getStdNameIndex("SELLCALF_DAIRY"));
 				else excess_dairy_calf = 2;
 
 				// if excess demand   > 10%
@@ -24,7 +24,6 @@ struct PlA {                  // Plot appearance
     int number;
     int state;
     int soil_type;
-    string soil_name;
     int farm_id;
 };
 
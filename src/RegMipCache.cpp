@@ -0,0 +1,90 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in 
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// RegMipCache.cpp
+//---------------------------------------------------------------------------
+#include "RegMipCache.h"
+
+RegMipCache::RegMipCache(size_t maxbytes)
+    : max_bytes(maxbytes/SHARDS) {}
+
+size_t
+RegMipCache::entrySize(const string& key, const Result& r) {
+    return key.size() + r.x.size()*sizeof(double) + sizeof(Entry) + 64;
+}
+
+bool
+RegMipCache::mayContain(uint64_t hash) const {
+    const Shard& s = shard(hash);
+    lock_guard<mutex> lock(s.m);
+    return s.index.count(hash) > 0;
+}
+
+bool
+RegMipCache::find(uint64_t hash, const string& key, Result& r) {
+    Shard& s = shard(hash);
+    lock_guard<mutex> lock(s.m);
+    unordered_map<uint64_t, EntryList::iterator>::iterator it = s.index.find(hash);
+    // another problem of the same hash is a miss
+    if (it == s.index.end() || it->second->key != key) {
+        s.misses++;
+        return false;
+    }
+    s.hits++;
+    s.entries.splice(s.entries.begin(), s.entries, it->second);
+    r = it->second->result;
+    return true;
+}
+
+// of two problems with the same hash the first one is kept
+void
+RegMipCache::insert(uint64_t hash, const string& key, const Result& r) {
+    Shard& s = shard(hash);
+    lock_guard<mutex> lock(s.m);
+    size_t sz = entrySize(key, r);
+    if (sz > max_bytes || s.index.count(hash))
+        return;
+    while (s.bytes + sz > max_bytes) {
+        EntryList::iterator last = --s.entries.end();
+        s.bytes -= entrySize(last->key, last->result);
+        s.index.erase(last->hash);
+        s.entries.erase(last);
+        s.evictions++;
+    }
+    Entry e;
+    e.hash = hash;
+    e.key = key;
+    e.result = r;
+    s.entries.push_front(e);
+    s.index[hash] = s.entries.begin();
+    s.bytes += sz;
+}
+
+void
+RegMipCache::printStatistics(ostream& out) const {
+    long hits = 0, misses = 0, evictions = 0;
+    size_t bytes = 0, entries = 0;
+    for (int i = 0; i < SHARDS; i++) {
+        lock_guard<mutex> lock(shards[i].m);
+        hits += shards[i].hits;
+        misses += shards[i].misses;
+        evictions += shards[i].evictions;
+        bytes += shards[i].bytes;
+        entries += shards[i].entries.size();
+    }
+    long n = hits + misses;
+    out << "MIP cache: " << hits << " hits, " << misses << " misses";
+    if (n > 0)
+        out << " (" << (100.0*hits)/n << "% hits)";
+    out << ", " << evictions << " evictions, " << entries << " entries, "
+        << bytes/(1024*1024) << " MB" << endl;
+}
@@ -0,0 +1,123 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in 
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+//---------------------------------------------------------------------------
+// RegMipCache.h
+//---------------------------------------------------------------------------
+#ifndef RegMipCacheH
+#define RegMipCacheH
+
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <ostream>
+#include <mutex>
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+
+/** RegMipCache class.
+    @short results of solved farm MIPs, shared by all farms of a simulation.
+    Entries are found by a 64-bit hash of the canonical problem image
+    (RegLpInfo::mipKey). The image is kept with the entry, and a hit
+    returns a result only if the image is equal, so it is exactly what
+    the solver returned for the same problem. The cache is split into
+    shards by hash. Each shard has its own lock and its own share of the
+    memory cap, and evicts its least recently used entries first. Replications
+    running at once (JOBS) thus rarely wait for each other.
+*/
+class RegMipCache {
+public:
+    struct Result {
+        long stat;
+        double objval;
+        vector<double> x;
+    };
+    /** 64-bit hash of a byte image given in pieces, the same pieces give
+        the same hash */
+    class Hasher {
+    public:
+        Hasher() : h(0x9e3779b97f4a7c15ULL), n(0) {}
+        void put(const void* p, size_t len) {
+            const unsigned char* c = (const unsigned char*)p;
+            while (len >= 8) {
+                uint64_t w;
+                memcpy(&w, c, 8);
+                mix(w);
+                c += 8;
+                len -= 8;
+            }
+            if (len > 0) {
+                uint64_t w = 0;
+                memcpy(&w, c, len);
+                mix(w ^ ((uint64_t)len << 56));
+            }
+        }
+        uint64_t value() const {
+            uint64_t x = h ^ n;
+            x ^= x >> 33;
+            x *= 0xff51afd7ed558ccdULL;
+            x ^= x >> 33;
+            return x;
+        }
+    private:
+        void mix(uint64_t w) {
+            w *= 0x87c37b91114253d5ULL;
+            w = (w << 31) | (w >> 33);
+            w *= 0x4cf5ad432745937fULL;
+            h ^= w;
+            h = ((h << 27) | (h >> 37))*5 + 0x52dce729;
+            n++;
+        }
+        uint64_t h;
+        uint64_t n;
+    };
+    RegMipCache(size_t max_bytes);
+    /// true if an entry has the hash, find() confirms it with the image
+    bool mayContain(uint64_t hash) const;
+    /// copies the cached result of the problem with image key into r
+    bool find(uint64_t hash, const string& key, Result& r);
+    void insert(uint64_t hash, const string& key, const Result& r);
+    void printStatistics(ostream& out) const;
+private:
+    static const int SHARDS = 16;
+    struct Entry {
+        uint64_t hash;
+        string key;
+        Result result;
+    };
+    typedef list<Entry> EntryList;
+    struct Shard {
+        /// most recently used first
+        EntryList entries;
+        unordered_map<uint64_t, EntryList::iterator> index;
+        size_t bytes;
+        long hits;
+        long misses;
+        long evictions;
+        mutable mutex m;
+        Shard() : bytes(0), hits(0), misses(0), evictions(0) {}
+    };
+    Shard shards[SHARDS];
+    size_t max_bytes;
+    Shard& shard(uint64_t hash) {
+        return shards[hash >> 60];
+    }
+    const Shard& shard(uint64_t hash) const {
+        return shards[hash >> 60];
+    }
+    static size_t entrySize(const string& key, const Result& r);
+};
+
+#endif
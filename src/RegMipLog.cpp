@@ -0,0 +1,70 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in 
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// RegMipLog.cpp
+//---------------------------------------------------------------------------
+#include "RegMipLog.h"
+extern "C" {
+    #include "glpk.h"
+}
+
+RegMipLog::RegMipLog(string d) : dir(d) {
+    out.open((dir+"mip_log.csv").c_str(), ios::trunc);
+    out << "phase,iteration,farm_id,farm_name,cached,status,time,iterations,"
+        << "nodes,rows_removed,cols_removed,gap\n";
+}
+
+void
+RegMipLog::Sum::add(const Record& r) {
+    solves++;
+    if (r.cached)
+        cached++;
+    if (r.status != GLP_OPT)
+        not_optimal++;
+    time += r.time;
+    if (r.time > max_time)
+        max_time = r.time;
+    iterations += r.stats.iterations;
+    nodes += r.stats.nodes;
+}
+
+void
+RegMipLog::add(const Record& r) {
+    lock_guard<mutex> lock(m);
+    out << r.phase << "," << r.iteration << "," << r.farm_id << ","
+        << r.farm_name << "," << r.cached << "," << r.status << ","
+        << r.time << "," << r.stats.iterations << "," << r.stats.nodes << ","
+        << r.stats.rows_removed << "," << r.stats.cols_removed << ","
+        << r.stats.gap << "\n";
+    phases[r.phase].add(r);
+    farms[r.farm_name].add(r);
+}
+
+void
+RegMipLog::writeSums(string file, string key, const map<string,Sum>& sums) {
+    ofstream s(file.c_str(), ios::trunc);
+    s << key << ",solves,cached,not_optimal,time,mean_time,max_time,iterations,nodes\n";
+    for (map<string,Sum>::const_iterator it=sums.begin();it!=sums.end();++it) {
+        const Sum& m = it->second;
+        s << it->first << "," << m.solves << "," << m.cached << "," << m.not_optimal
+          << "," << m.time << "," << (m.solves ? m.time/m.solves : 0) << ","
+          << m.max_time << "," << m.iterations << "," << m.nodes << "\n";
+    }
+}
+
+void
+RegMipLog::writeSummary() {
+    lock_guard<mutex> lock(m);
+    out.flush();
+    writeSums(dir+"mip_phases.csv", "phase", phases);
+    writeSums(dir+"mip_farms.csv", "farm_name", farms);
+}
@@ -0,0 +1,85 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in 
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// RegMipLog.h
+//---------------------------------------------------------------------------
+#ifndef RegMipLogH
+#define RegMipLogH
+
+#include <string>
+#include <map>
+#include <fstream>
+#include <mutex>
+
+using namespace std;
+
+/// work of one MIP solve as reported by GLPK
+struct RegMipStats {
+    /// simplex iterations
+    long iterations;
+    /// branch and bound nodes
+    long nodes;
+    /// rows and columns removed by the MIP presolver
+    int rows_removed;
+    int cols_removed;
+    /// relative gap between the incumbent and the best bound
+    double gap;
+    RegMipStats() : iterations(0), nodes(0), rows_removed(0), cols_removed(0), gap(0) {}
+};
+
+/** RegMipLog class.
+    @short one line per farm MIP solve in mip_log.csv, tagged with the
+    phase, iteration and farm of the solve. At the end of the run
+    writeSummary() writes the totals per phase (mip_phases.csv) and
+    per farm name (mip_farms.csv).
+*/
+class RegMipLog {
+public:
+    struct Record {
+        string phase;
+        int iteration;
+        int farm_id;
+        string farm_name;
+        /// result taken from the MIP cache
+        bool cached;
+        /// GLPK status of the solution (GLP_OPT, ...)
+        int status;
+        /// wall time in seconds
+        double time;
+        RegMipStats stats;
+    };
+    /// @param dir output directory
+    RegMipLog(string dir);
+    void add(const Record& r);
+    void writeSummary();
+private:
+    struct Sum {
+        long solves;
+        long cached;
+        long not_optimal;
+        double time;
+        double max_time;
+        long iterations;
+        long nodes;
+        Sum() : solves(0), cached(0), not_optimal(0), time(0), max_time(0),
+            iterations(0), nodes(0) {}
+        void add(const Record& r);
+    };
+    string dir;
+    ofstream out;
+    map<string,Sum> phases;
+    map<string,Sum> farms;
+    mutex m;
+    static void writeSums(string file, string key, const map<string,Sum>& sums);
+};
+
+#endif
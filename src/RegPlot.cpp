@@ -17,133 +17,42 @@
 #include "RegMessages.h"
 #include <algorithm>
 #include <iostream>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define REGPLOT_SSE2
+#endif
 using namespace std;
 
 //soil service
 double RegPlotInfo::getCarbon(){
-	return carbon;
+	return store->carbon[slot];
 }
 
 void RegPlotInfo::setCarbon(double c) {
-	carbon=c;
+	store->carbon[slot]=c;
 	return;
 }
 
-//	CONSTRUCTOR
-RegPlotInfo::RegPlotInfo(RegGlobalsInfo* G,
-                         int pos,
-                         int xcol,
-                         int yrow,
-                         vector<RegPlotInfo*>& r) :g(G), region(&r) {
-	carbon = 0;
-    paid_tacs=0;
-    tacs=0;
-    PA.state = 0;
-    PA.number = pos;
-    PA.col = xcol;
-    PA.row = yrow;
-    newley_rented = false;
-    rent_paid = -1;
-    second_offer = rent_paid;
-    distance_from_agent = -1;
-    rented_by_agent = -1;
-    previously_rented_by_agent=-1;
-    previously_rented_by_legal_type=-1;
-    previously_paid_by_agent=0;
-    payment_entitlement = 0;
-    initial_payment_entitlement = 0;
-    occupied_by_agent = -1;
-    previously_occupied_by_agent = -1;
-    distance_costs = 0;
-    contract_length=0;
-    obj_backup=NULL;
-
-    update=false;
-    for (int i=0;i<g->NO_OF_SOIL_TYPES;i++) {
-        plot_p.push_back(0);
-    }
-
-    tagv=false;
-    checked = false;
-}
-RegPlotInfo::RegPlotInfo(RegPlotInfo& rh,
-                         RegGlobalsInfo* G,
-                         vector<RegPlotInfo*>& r) :region(&r) {
-    obj_backup=NULL;
-    g=G;
-    PA=rh.PA;
-    paid_tacs=rh.paid_tacs;
-    tacs=rh.tacs;
-    contract_length=rh.contract_length;
-    distance_from_agent=rh.distance_from_agent;
-    rent_paid=rh.rent_paid;
-    second_offer = rh.second_offer;
-    payment_entitlement=rh.payment_entitlement;
-    initial_payment_entitlement=rh.initial_payment_entitlement;
-    rented_by_agent=rh.rented_by_agent;
-    occupied_by_agent=rh.occupied_by_agent;
-    previously_rented_by_agent=rh.previously_rented_by_agent;
-    previously_occupied_by_agent=rh.previously_occupied_by_agent;
-    distance_costs=rh.distance_costs;
-    newley_rented=rh.newley_rented;
-
-    tagv=rh.tagv;
-    update=rh.update;
-    plot_id=rh.plot_id;
-    checked=rh.checked;
-    plot_p=rh.plot_p;
-    rented_by_legal_type=rh.rented_by_legal_type;
-    previously_rented_by_legal_type=rh.previously_rented_by_legal_type;
-    previously_paid_by_agent=rh.previously_paid_by_agent;
-    free_plots=rh.free_plots;
-
-    dist=rh.dist;
-}
-void
-RegPlotInfo::finish(RegPlotInfo& rh) {
-    for (unsigned int i=0;i<rh.free_plots.size();i++) {
-        for (unsigned int j=0;j<rh.free_plots[i].size();j++) {
-            free_plots[i][j].plot=(*region)[rh.free_plots[i][j].plot->getId()];
-        }
-    }
-    for (unsigned int j=0;j<rh.contiguous_plot.size();j++) {
-        contiguous_plot.push_back((*region)[rh.contiguous_plot[j]->getId()]);
-    }
-    pl_n.resize(rh.pl_n.size());
-    if (rh.pl_n.size()>0) {
-        for (int i=0;i<g->NO_OF_SOIL_TYPES;i++) {
-            pl_n[i].resize(rh.pl_n[i].size());
-        }
-        for (int i=0;i<g->NO_OF_SOIL_TYPES;i++) {
-            for (unsigned int j=0;j<rh.pl_n[i].size();j++) {
-                pl_n[i][j]=(*region)[rh.pl_n[i][j]->getId()];
-            }
-        }
-    }
-}
-void RegPlotInfo::backup() {
-    obj_backup=new RegPlotInfo(*this);
-}
-void RegPlotInfo::restore() {
-    RegPlotInfo* tmp=obj_backup;
-    *this=*obj_backup;
-    obj_backup=tmp;
-}
-//--------------
-//	DESTRUCTOR
-//--------------
-RegPlotInfo::~RegPlotInfo() {
-    if (obj_backup) delete obj_backup;
+string
+RegPlotInfo::getSoilName() {
+    RegGlobalsInfo* g=store->g;
+    int soil_type=getSoilType();
+    if (soil_type>=0 && soil_type<g->NO_OF_SOIL_TYPES)
+        return g->NAMES_OF_SOIL_TYPES[soil_type];
+    return "NON_AG";
 }
 //------------------------
 //	DISTANCE BETWEEN PLOTS
 //------------------------
 double
 RegPlotInfo::calculateDistance(const RegPlotInfo* P) {
+    RegGlobalsInfo* g=store->g;
+    int row=getRow();
+    int col=getCol();
     double d;
     if (P != 0) {
-        double dx = min(abs(PA.col - P->PA.col),(g->NO_COLS - abs(PA.col - P->PA.col)));
-        double dy = min(abs((PA.row - P->PA.row)),(g->NO_ROWS - abs(PA.row - P->PA.row)));
+        double dx = min(abs(col - P->getCol()),(g->NO_COLS - abs(col - P->getCol())));
+        double dy = min(abs((row - P->getRow())),(g->NO_ROWS - abs(row - P->getRow())));
         d = sqrt((dx * dx) + (dy * dy));
         return d;
     } else
@@ -152,19 +61,60 @@ RegPlotInfo::calculateDistance(const RegPlotInfo* P) {
 
 double
 RegPlotInfo::calculateDistanceCosts(const RegPlotInfo* P) {
+    RegGlobalsInfo* g=store->g;
     double dist=sqrt(g->PLOT_SIZE)/10;
     return dist*g->TRANSPORT_COSTS*calculateDistance(P);
 }
 
+// out[i] = k*sqrt(dx2+dy2[i]); sqrt is exact in SSE2 as well, so the
+// results equal those of calculateDistanceCosts()
+static void distanceCostsOfColumn(double k, double dx2, const double* dy2,
+                                  double* out, int n) {
+    int i=0;
+#ifdef REGPLOT_SSE2
+    __m128d kv=_mm_set1_pd(k);
+    __m128d dxv=_mm_set1_pd(dx2);
+    for (;i+2<=n;i+=2) {
+        __m128d d=_mm_sqrt_pd(_mm_add_pd(dxv,_mm_loadu_pd(dy2+i)));
+        _mm_storeu_pd(out+i,_mm_mul_pd(kv,d));
+    }
+#endif
+    for (;i<n;i++)
+        out[i]=k*sqrt(dx2+dy2[i]);
+}
+
+// plots are stored column by column, so within a column only the
+// row distance changes
+void
+RegPlotInfo::calculateDistanceCosts(vector<double>& costs) {
+    RegGlobalsInfo* g=store->g;
+    int row=getRow();
+    int col=getCol();
+    int rows=g->NO_ROWS;
+    int cols=g->NO_COLS;
+    double k=sqrt(g->PLOT_SIZE)/10*g->TRANSPORT_COSTS;
+    vector<double> dy2(rows);
+    for (int r=0;r<rows;r++) {
+        double dy=min(abs(row-r),rows-abs(row-r));
+        dy2[r]=dy*dy;
+    }
+    costs.resize(rows*cols);
+    for (int c=0;c<cols;c++) {
+        double dx=min(abs(col-c),cols-abs(col-c));
+        distanceCostsOfColumn(k,dx*dx,&dy2[0],&costs[c*rows],rows);
+    }
+}
+
 void
 RegPlotInfo::setDistanceFromAgent(double dfa) {
+    RegGlobalsInfo* g=store->g;
     // distance_from_agent is otherwise never needed
-    distance_from_agent = dfa;
+    store->distance_from_agent[slot] = dfa;
     // normalisation of distance to be expressed in km
     // 10 is conversion factor from ha in km
     // dist is the border length of a plot
     double dist=sqrt(g->PLOT_SIZE)/10;
-    distance_costs = dist*g->TRANSPORT_COSTS*dfa;
+    store->distance_costs[slot] = dist*g->TRANSPORT_COSTS*dfa;
 }
 //-------------------------------------
 //	FIND FREE PLOT CLOSEST TO THIS CELL
@@ -175,65 +125,58 @@ RegPlotInfo::checkPlot(int n,int type) {
 //    dist = calculateDistance((*region)[n]);
 //    (*region)[n]->setDistanceFromAgent(dist);
     // check for plot n whether it is of type type
-    if (type==(*region)[n]->getSoilType() && (*region)[n]->getState()==0) return true;
+    int s=store->slot[n];
+    if (type==store->soil_type[s] && store->state[s]==0) return true;
     else return false;
 }
 
 RegPlotInfo*
 RegPlotInfo::findFreePlotOfType(int type) {
-    if (g->FAST_PLOT_SEARCH && pl_n.size()>0) {
-        for (unsigned int i=plot_p[type];i<pl_n[type].size();i++) {
-            if (pl_n[type][i]->getState()==0) {
-                plot_p[type]=i;
-                return pl_n[type][i];
+    RegGlobalsInfo* g=store->g;
+    vector<RegPlotInfo*>* region=store->region;
+    int row=getRow();
+    int col=getCol();
+    // find free plot in (*region)
+    // mechanism is that 4 direct neighbours are checked an then
+    // the region is rotated and the 4 diagonal neighbours are
+    // checked. This is repeated for the VISION of the farm,
+    // which is currently the whole region
+
+    int j;
+    for (int i=1;i<=g->VISION;i++) {
+        j=0;
+        do {
+            int n,o,s,w;  // coordinates Nord, Ost, Sued, West
+            //plot to the north
+            n=((row-i+g->NO_ROWS)%g->NO_ROWS)+(((col+j+g->NO_COLS)%g->NO_COLS)*g->NO_ROWS);
+            if (checkPlot(n,type)) {
+                return (*region)[n];
             }
-        }
-        plot_p[type]=pl_n[type].size();
-        return NULL;
-
-    } else {
-        // find free plot in (*region)
-        // mechanism is that 4 direct neighbours are checked an then
-        // the region is rotated and the 4 diagonal neighbours are
-        // checked. This is repeated for the VISION of the farm,
-        // which is currently the whole region
-
-        int j;
-        for (int i=1;i<=g->VISION;i++) {
-            j=0;
-            do {
-                int n,o,s,w;  // coordinates Nord, Ost, Sued, West
-                //plot to the north
-                n=((PA.row-i+g->NO_ROWS)%g->NO_ROWS)+(((PA.col+j+g->NO_COLS)%g->NO_COLS)*g->NO_ROWS);
-                if (checkPlot(n,type)) {
-                    return (*region)[n];
-                }
-                // plot to the east
-                o=((PA.row+j+g->NO_ROWS)%g->NO_ROWS)+(((PA.col+i+g->NO_COLS)%g->NO_COLS)*g->NO_ROWS);
-                if (checkPlot(o,type)) {
-                    return (*region)[o];
-                }
-                // plot to the south
-                s=((PA.row+i+g->NO_ROWS)%g->NO_ROWS)+(((PA.col-j+g->NO_COLS)%g->NO_COLS)*g->NO_ROWS);
-                if (checkPlot(s,type)) {
-                    return (*region)[s];
-                }
-                // plot to the west
-                w=((PA.row-j+g->NO_ROWS)%g->NO_ROWS)+(((PA.col-i+g->NO_COLS)%g->NO_COLS)*g->NO_ROWS);
-                if (checkPlot(w,type)) {
-                    return (*region)[w];
-                }
-                if (j > 0) { // rotates horizon to the right and left
-                    j*=-1;
-                } else {
-                    j*=-1;
-                    j+=1;
-                }
-            } while (j <= i);
-        }
-        // if no free plot is left
-        return NULL;
+            // plot to the east
+            o=((row+j+g->NO_ROWS)%g->NO_ROWS)+(((col+i+g->NO_COLS)%g->NO_COLS)*g->NO_ROWS);
+            if (checkPlot(o,type)) {
+                return (*region)[o];
+            }
+            // plot to the south
+            s=((row+i+g->NO_ROWS)%g->NO_ROWS)+(((col-j+g->NO_COLS)%g->NO_COLS)*g->NO_ROWS);
+            if (checkPlot(s,type)) {
+                return (*region)[s];
+            }
+            // plot to the west
+            w=((row-j+g->NO_ROWS)%g->NO_ROWS)+(((col-i+g->NO_COLS)%g->NO_COLS)*g->NO_ROWS);
+            if (checkPlot(w,type)) {
+                return (*region)[w];
+            }
+            if (j > 0) { // rotates horizon to the right and left
+                j*=-1;
+            } else {
+                j*=-1;
+                j+=1;
+            }
+        } while (j <= i);
     }
+    // if no free plot is left
+    return NULL;
 }
 
 bool alternative_comp(const RegPlotInformationInfo &p1, const RegPlotInformationInfo &p2)
@@ -243,6 +186,8 @@ bool alternative_comp(const RegPlotInformationInfo &p1, const RegPlotInformation
 
 RegPlotInformationInfo
 RegPlotInfo::findMostPreferablePlotOfType(int type, RegFarmInfo* farm) {
+    RegGlobalsInfo* g=store->g;
+    vector<RegPlotInfo*>* region=store->region;
 	if (g->WEIGHTED_PLOT_SEARCH) {
 		RegPlotInformationInfo pinfo_best;
 		RegPlotInformationInfo pinfo_curr;
@@ -269,12 +214,14 @@ RegPlotInfo::findMostPreferablePlotOfType(int type, RegFarmInfo* farm) {
 		return pinfo_best;
 	}
 	else
-		return findMostPreferablePlotOfType(type);
+		return findMostPreferablePlotOfType(type, farm->getFarmsteadSearch());
 }
 
 RegPlotInformationInfo
-RegPlotInfo::findMostPreferablePlotOfType(int type) {
+RegPlotInfo::findMostPreferablePlotOfType(int type, RegFarmsteadSearch& s) {
+    RegGlobalsInfo* g=store->g;
     if (g->WEIGHTED_PLOT_SEARCH) {
+        vector< vector<RegPlotInformationInfo> >& free_plots=s.free_plots;
         if (free_plots[type].size()==0) {
             return RegPlotInformationInfo();
         }
@@ -311,8 +258,20 @@ RegPlotInfo::findMostPreferablePlotOfType(int type) {
 //-------------------------------------
 void
 RegPlotInfo::setState(const int passState,RegFarmInfo* farm, int colour) {
-    PA.state = passState;
-    switch (PA.state) {
+    double& rent_paid=store->rent_paid[slot];
+    double& second_offer=store->second_offer[slot];
+    double& previously_paid_by_agent=store->previously_paid_by_agent[slot];
+    double& distance_costs=store->distance_costs[slot];
+    double& paid_tacs=store->paid_tacs[slot];
+    int& rented_by_agent=store->rented_by_agent[slot];
+    int& previously_rented_by_agent=store->previously_rented_by_agent[slot];
+    int& occupied_by_agent=store->occupied_by_agent[slot];
+    int& previously_occupied_by_agent=store->previously_occupied_by_agent[slot];
+    signed char& rented_by_legal_type=store->rented_by_legal_type[slot];
+    signed char& previously_rented_by_legal_type=store->previously_rented_by_legal_type[slot];
+    char& newley_rented=store->newley_rented[slot];
+    store->state[slot] = passState;
+    switch (passState) {
     case -1: // dead_plot
         rent_paid          = 0;
         second_offer = rent_paid;
@@ -371,13 +330,12 @@ RegPlotInfo::setState(const int passState,RegFarmInfo* farm, int colour) {
         distance_costs     = 0;
         newley_rented      = false;
     }
-    PA.farm_id=occupied_by_agent;
     // draw plot immediately if the object Draw exists.
 }
 void
 RegPlotInfo::setPaymentEntitlement(double pe) {
-    payment_entitlement = pe;
-    initial_payment_entitlement = pe;
+    store->payment_entitlement[slot] = pe;
+    store->initial_payment_entitlement[slot] = pe;
 }
 // identify the plots in the neighbourhood that have state state
 
@@ -405,18 +363,21 @@ RegPlotInfo::identifyPlotsSameStateAndFarm(const int& farmnumber) {
 
 int
 RegPlotInfo::identifyContiguousPlot(bool check_soiltype, bool check_farmnumber,bool check_previous_farmnumber,int farmnumberob,bool mark_update) {
+    RegGlobalsInfo* g=store->g;
+    vector<RegPlotInfo*>* region=store->region;
+    vector<int>& contiguous_plot=store->contiguous_plot[plot_id];
     list<RegPlotInfo*> queue;
-    contiguous_plot.push_back(this);
+    contiguous_plot.push_back(plot_id);
     queue.push_back(this);
     int counter=1;
     this->tag();
-    if (mark_update) update =true;
+    if (mark_update) setUpdate(true);
     int soiltype=this->getSoilType();
     int farmnumber;
-    if (occupied_by_agent!=-1)
-        farmnumber=occupied_by_agent;
+    if (getOccupiedByAgent()!=-1)
+        farmnumber=getOccupiedByAgent();
     else
-        farmnumber=rented_by_agent;
+        farmnumber=getRentedByAgent();
     if (farmnumberob!=-1)
         farmnumber=farmnumberob;
     while (queue.size()>0) {
@@ -433,9 +394,9 @@ RegPlotInfo::identifyContiguousPlot(bool check_soiltype, bool check_farmnumber,b
                 ((*region)[n]->getTag()==false) &&
                 ((*region)[n]->getState()!=-1)       ) {
             (*region)[n]->tag();
-            if (mark_update) update =true;
+            if (mark_update) setUpdate(true);
             counter++;
-            contiguous_plot.push_back((*region)[n]) ;
+            contiguous_plot.push_back(n);
             queue.push_back((*region)[n]);
         }
         // plot to the east
@@ -446,9 +407,9 @@ RegPlotInfo::identifyContiguousPlot(bool check_soiltype, bool check_farmnumber,b
                 ((*region)[o]->getTag()==false) &&
                 ((*region)[o]->getState()!=-1)       ) {
             (*region)[o]->tag();
-            if (mark_update) update =true;
+            if (mark_update) setUpdate(true);
             counter++;
-            contiguous_plot.push_back((*region)[o]) ;
+            contiguous_plot.push_back(o);
             queue.push_back((*region)[o]);
         }
         // plot to the south
@@ -459,9 +420,9 @@ RegPlotInfo::identifyContiguousPlot(bool check_soiltype, bool check_farmnumber,b
                 ((*region)[s]->getTag()==false) &&
                 ((*region)[s]->getState()!=-1)       ) {
             (*region)[s]->tag();
-            if (mark_update) update =true;
+            if (mark_update) setUpdate(true);
             counter++;
-            contiguous_plot.push_back((*region)[s]) ;
+            contiguous_plot.push_back(s);
             queue.push_back((*region)[s]);
         }
         // plot to the west
@@ -471,9 +432,9 @@ RegPlotInfo::identifyContiguousPlot(bool check_soiltype, bool check_farmnumber,b
                 ((*region)[w]->getTag()==false) &&
                 ((*region)[w]->getState()!=-1)       ) {
             (*region)[w]->tag();
-            if (mark_update) update =true;
+            if (mark_update) setUpdate(true);
             counter++;
-            contiguous_plot.push_back((*region)[w]) ;
+            contiguous_plot.push_back(w);
             queue.push_back((*region)[w]);
         }
     }
@@ -485,8 +446,10 @@ RegPlotInfo::calcShareOfContiguousPlot(int farmnumber) {
     double own=0;
     double total=0;
     identifyContiguousPlot(true,true,false);
+    vector<int>& contiguous_plot=store->contiguous_plot[plot_id];
     for (unsigned int j=0;j<contiguous_plot.size();j++) {
-        if ( contiguous_plot[j]->getRentedByAgent()   == farmnumber || contiguous_plot[j]->getOccupiedByAgent() == farmnumber) {
+        int s=store->slot[contiguous_plot[j]];
+        if ( store->rented_by_agent[s]   == farmnumber || store->occupied_by_agent[s] == farmnumber) {
             own+=1;
         }
         total+=1;
@@ -511,49 +474,31 @@ RegPlotInfo::countContiguousPlots() {
     return c;
 }
 
-void
-RegPlotInfo::finish(RegRegionInfo* r) {
-    if (g->FAST_PLOT_SEARCH && PA.state==2)  {
-        plot_p.clear();
-        dist.clear();
-        pl_n.clear();
-        pl_n.resize(g->NO_OF_SOIL_TYPES);
-        dist.resize(g->NO_OF_SOIL_TYPES);
-        for (int i=0;i<g->NO_OF_SOIL_TYPES;i++) {
-            plot_p.push_back(0);
-            pl_n[i].resize(r->getNumberOfLandPlotsOfType(i));
-            dist[i].resize(r->getNumberOfLandPlotsOfType(i));
-        }
-        for (int t=0;t<g->NO_OF_SOIL_TYPES;t++) {
-            int counter =0;
-            for (int j=0;j<g->NO_COLS*g->NO_ROWS;j++) {
-                if ((*region)[j]->getSoilType()==t) {
-                    dist[t][counter]=calculateDistanceCosts((*region)[j]);
-                    pl_n[t][counter]=(*region)[j];
-                    counter++;
-                }
-            }
-            
-            vector<double>::iterator a=dist[t].begin();
-            vector<RegPlotInfo*>::iterator b=pl_n[t].begin();
-            quicksort(&(*a),&(*b),0,pl_n[t].size()-1);
-			
-        }
-    }
-}
-
-
 void
 RegPlotInfo::initFreePlots(RegFarmInfo* farm) {
+    RegGlobalsInfo* g=store->g;
+    vector<RegPlotInfo*>* region=store->region;
+    RegFarmsteadSearch& s=farm->getFarmsteadSearch();
+    vector< vector<RegPlotInformationInfo> >& free_plots=s.free_plots;
+    vector<bool>& uniform_pe=s.uniform_pe;
+    vector<int>& free_plot_slot=s.free_plot_slot;
     free_plots.clear();
+    uniform_pe.clear();
+    free_plot_slot.clear();
+    vector<double> costs;
+    calculateDistanceCosts(costs);
     for (int i=0;i<g->NO_OF_SOIL_TYPES;i++) {
         vector<RegPlotInformationInfo> tmp_p;
+        bool uniform=true;
         for (unsigned int j=0;j<(*region).size();j++) {
             if (checkPlot(j,i)) {
-                RegPlotInformationInfo pi=calculateValue((*region)[j],farm);
+                RegPlotInformationInfo pi=calculateValue((*region)[j],farm,costs[j]);
+                if (tmp_p.size()>0 && pi.pe!=tmp_p[0].pe)
+                    uniform=false;
                 tmp_p.push_back(pi);
              }
         }
+        uniform_pe.push_back(uniform);
 
         if(g->SWEDEN) {
           sort(tmp_p.begin(),tmp_p.end(),alternative_comp);
@@ -568,13 +513,37 @@ RegPlotInfo::initFreePlots(RegFarmInfo* farm) {
     }
 }
 
+// the lists keep rented plots until the next initFreePlots(),
+// so the positions stay valid until then
+void
+RegPlotInfo::indexFreePlots(RegFarmsteadSearch& s) {
+    vector<RegPlotInfo*>* region=store->region;
+    vector< vector<RegPlotInformationInfo> >& free_plots=s.free_plots;
+    vector<int>& free_plot_slot=s.free_plot_slot;
+    free_plot_slot.assign((*region).size(), -1);
+    for (unsigned int t=0;t<free_plots.size();t++) {
+        for (unsigned int i=0;i<free_plots[t].size();i++) {
+            int id=free_plots[t][i].plot->getId();
+            if (free_plot_slot[id]<0)
+                free_plot_slot[id]=i;
+        }
+    }
+}
+
 RegPlotInformationInfo RegPlotInfo::getValue(RegPlotInfo* plot, RegFarmInfo* farm) {
+    RegGlobalsInfo* g=store->g;
     if (g->WEIGHTED_PLOT_SEARCH) {
         int type=plot->getSoilType();
-        for (unsigned int i=0;i<free_plots[type].size();i++) {
-            if (free_plots[type][i].plot->getId()==plot->getId())
-                  return free_plots[type][i];
-
+        RegFarmsteadSearch& s=farm->getFarmsteadSearch();
+        vector< vector<RegPlotInformationInfo> >& free_plots=s.free_plots;
+        vector<int>& free_plot_slot=s.free_plot_slot;
+        if (type<(int)free_plots.size() && free_plots[type].size()>0) {
+            if (free_plot_slot.empty())
+                indexFreePlots(s);
+            int slot=free_plot_slot[plot->getId()];
+            if (slot>=0 && slot<(int)free_plots[type].size()
+                    && free_plots[type][slot].plot->getId()==plot->getId())
+                return free_plots[type][slot];
         }
         return calculateValue(plot,farm);
     } else {
@@ -582,9 +551,14 @@ RegPlotInformationInfo RegPlotInfo::getValue(RegPlotInfo* plot, RegFarmInfo* far
     }
 }
 RegPlotInformationInfo RegPlotInfo::calculateValue(RegPlotInfo* plot, RegFarmInfo* farm) {
+    return calculateValue(plot,farm,calculateDistanceCosts(plot));
+}
+
+RegPlotInformationInfo RegPlotInfo::calculateValue(RegPlotInfo* plot, RegFarmInfo* farm, double tc) {
+    RegGlobalsInfo* g=store->g;
     int farm_id=farm->getFarmId();
     RegPlotInformationInfo pc;
-    pc.tc=calculateDistanceCosts(plot);
+    pc.tc=tc;
     pc.pe=plot->getPaymentEntitlement();
     pc.farm_tac=0;
     pc.tac=0;
@@ -623,7 +597,7 @@ RegPlotInformationInfo RegPlotInfo::calculateValue(RegPlotInfo* plot, RegFarmInf
                 if (g->USE_HISTORICAL_CONTIGUOUS_PLOTS)  {
                     neighbours = plot->identifyPreviousPlotsSameState(farm_id);
                 } else {
-                    neighbours = plot->identifyPlotsSameStateAndFarm(farm_id);
+                    neighbours = farm->countNeighbouringPlots(plot);
                 }
                 pc.farm_tac=pc.tac = -neighbours * g->RENT_ADJUST_COEFFICIENT_N;
                 if(g->SWEDEN) {
@@ -644,12 +618,15 @@ RegPlotInformationInfo RegPlotInfo::calculateValue(RegPlotInfo* plot, RegFarmInf
 }
 void
 RegPlotInfo::clearContiguousPlot() {
-    contiguous_plot.clear();
+    store->contiguous_plot.erase(plot_id);
 }
 
 void
 RegPlotInfo::untagContiguousPlot() {
-    for (unsigned int j=0;j<contiguous_plot.size();j++) {
-        contiguous_plot[j]->unTag();
+    unordered_map<int, vector<int> >::iterator it=store->contiguous_plot.find(plot_id);
+    if (it==store->contiguous_plot.end())
+        return;
+    for (unsigned int j=0;j<it->second.size();j++) {
+        store->tag[store->slot[it->second[j]]]=false;
     }
 }
@@ -17,69 +17,25 @@
 #include "RegGlobals.h"
 #include "RegFarm.h"
 #include "RegPlotInformation.h"
+#include "RegPlotStore.h"
+
+class RegFarmInfo;
+struct RegFarmsteadSearch;
 
 /** RegPlotInfo class.
-    The class manages each individual plot in the region
+    The class manages each individual plot in the region.
+    A RegPlotInfo is a handle of the RegPlotStore of the region, the data
+    of the plot are kept in the columns of the store at its slot.
     @author Kathrin Happe, Alfons Balmann, Konrad Kellermann
     @version June 2001
 */
 
 class RegPlotInfo {
 private:
-	//Soil service
-	double carbon;
-
-    int contract_length;
-    //Globals
-    RegGlobalsInfo* g;
-    /// manages visual state of plot
-    /** state a plot can take
-        \begin{itemize}
-            \item -1: dead plot
-            \item 0: idle  plot
-            \item 1: rented plot
-            \item 2: plot is farmstead
-            \item 3: plot is owned land
-        \end{itemize}
-    */
-    struct PlA PA;
-    /// distance from plot to farmstead of owner (tenant)
-    double   distance_from_agent;
-    /// rent paid for this plot
-    double   rent_paid;
-
-    /// second highest offer
-    double second_offer;
-
-    /// entitlement for direct payment
-    double   payment_entitlement;
-    /// initial payment entitlement
-    double   initial_payment_entitlement;
-    /// plot is rented by which farmNumber
-    int      rented_by_agent;
-    int      rented_by_legal_type;
-    int      previously_rented_by_legal_type;
-    double previously_paid_by_agent;
-    /// number of farm this plot is farmstead of
-    int      occupied_by_agent;
-    /// plot is rented by which farmNumber
-    int      previously_rented_by_agent;
-    /// number of farm this plot is farmstead of
-    int      previously_occupied_by_agent;
-    /// distance costs associated with this plot
-    double   distance_costs;
-    ///flag for the desicion if plot is newley rented
-    bool newley_rented;
-//    bool Draw;
-//    HWND Handle;
-    double paid_tacs;
-    double tacs;
-    /// vector to store the free plots in the region
-    /// this is done on individual level because the vector is then sorted  according the value of a plot
-    vector< vector<RegPlotInformationInfo> > free_plots;
-    vector<RegPlotInfo*> contiguous_plot;
-    /// reference to pointer of plots
-    vector <RegPlotInfo*>* region;
+    RegPlotStore* store;
+    int plot_id;
+    /// position of the plot in the columns of store
+    int slot;
     /** check status of plot n whether it is of type type
         @param type 1: arable land, 2: grassland
         @param n in dex of plots in Region
@@ -87,82 +43,54 @@ private:
                      false: if plot is not of type
     */
     bool checkPlot(int n, int type);
-    bool tagv;
-
-    //Fast plot search
-    vector < vector<RegPlotInfo*> > pl_n;
-    vector<int> plot_p;
-    vector < vector<double> > dist;
-
-    bool update;
-    int plot_id;
-    RegPlotInfo* obj_backup;
+    void indexFreePlots(RegFarmsteadSearch& s);
 public:
 	//soil service
 	double getCarbon();
 	void setCarbon(double);
 
-	void finish(RegPlotInfo& rh);
-    void backup();
-    void restore();
     bool getUpdate() {
-        return update;
+        return store->update[slot];
     };
     void setUpdate(bool update) {
-        this->update=update;
+        store->update[slot]=update;
     }
-    void resetPlotPointer() {
-        for (int i=0;i<g->NO_OF_SOIL_TYPES;i++) {
-            plot_p[i]=0;
-        }
-    };
+    /// fills the free plot lists of the farm whose farmstead this plot is
     void initFreePlots(RegFarmInfo* farm);
     void clearContiguousPlot();
     void untagContiguousPlot();
-    RegPlotInformationInfo findMostPreferablePlotOfType(int type);
+    /// first free plot of type in the lists s of this farmstead
+    RegPlotInformationInfo findMostPreferablePlotOfType(int type, RegFarmsteadSearch& s);
 	RegPlotInformationInfo findMostPreferablePlotOfType(int type, RegFarmInfo* farm);
 
     RegPlotInformationInfo calculateValue(RegPlotInfo* farm_plot, RegFarmInfo* farm);
+    /// as above with the distance costs tc of plot already known
+    RegPlotInformationInfo calculateValue(RegPlotInfo* plot, RegFarmInfo* farm, double tc);
     RegPlotInformationInfo getValue(RegPlotInfo* plot, RegFarmInfo* farm);
     int identifyContiguousPlot(bool check_soiltype, bool ckeck_farmnumber,bool ckeck_previous_farmnumber,int farmnumberob=-1,bool mark_update=false);
     /** constructor
-        @param G pointer to globals
-        @param pos number of plot
-        @param xcol column position of plot
-        @param yrow row position of plot
-        @param reference to vector of pointers to plots
-
-        Region is initialised with reference to vector of
-        pointers to plots passed from RegRegionInfo
+        @param s store of the region
+        @param id number of plot, plot (r,c) has the id c*NO_ROWS+r
+        @param sl position of the plot in the columns of s
     */
-    RegPlotInfo(RegGlobalsInfo* G,
-                int pos,
-                int xcol,
-                int yrow,
-                vector<RegPlotInfo*>& r);
-    RegPlotInfo(RegPlotInfo& rh,
-                RegGlobalsInfo* G,
-                vector<RegPlotInfo*>& r);
-    /// destructor
-    ~RegPlotInfo();
+    RegPlotInfo(RegPlotStore* s, int id, int sl)
+        : store(s), plot_id(id), slot(sl) {
+    }
 
    int getId() {
         return plot_id;
     };
-    void setId(int id) {
-        plot_id=id;
-    };
     double getPaidTacs() {
-        return paid_tacs;
+        return store->paid_tacs[slot];
     };
     void setPaidTacs(double t) {
-        paid_tacs=t;
+        store->paid_tacs[slot]=t;
     };
     double getTacs() {
-        return tacs;
+        return store->tacs[slot];
     };
     void setTacs(double t) {
-        tacs=t;
+        store->tacs[slot]=t;
     };
 
     /// itendify whether plot belongs to same farm
@@ -173,8 +101,6 @@ public:
     double calcShareOfContiguousPlot(int farmnumber);
     int countContiguousPlots(int farmnumber);
     int countContiguousPlots();
-    /// flag for counting algorithm
-    bool checked;
     /** method that returns pointer to free plot of type
         (1:arable, 2:grassland).
         The algorithm is such that first the direct neighbours
@@ -186,6 +112,10 @@ public:
 //    bool hasNeighbours(const int& farmid);
     double calculateDistance(const RegPlotInfo* P);
     double calculateDistanceCosts(const RegPlotInfo* P);
+    /** distance costs from this plot to all plots of the region,
+        costs[id] equals calculateDistanceCosts(plot id)
+    */
+    void calculateDistanceCosts(vector<double>& costs);
     /** The distance costs from plot to agent are calculated
         Here, the distance measure distance_from_agent is transformed
         to be expressed in terms of kilometres.
@@ -193,119 +123,112 @@ public:
     */
     void setDistanceFromAgent(double dfa);
     void setContractLength(int cl) {
-        contract_length=cl;
+        store->contract_length[slot]=cl;
     };
     int getContractLength() {
-        return contract_length;
+        return store->contract_length[slot];
     };
     void decreaseContractLength() {
-        contract_length--;
+        store->contract_length[slot]--;
     };
 
 	int getState()const {
-        return PA.state;
+        return store->state[slot];
     }
     /** change state of a plot
         @param s state
         @param farm pointer to farm that changes the state
         @param colour colour of plot
-
-        State and colour are changed in the PA struct, that
-        manages the visual state of the plot
     */
     void setState(const int passState,
                   RegFarmInfo* farm,
                   int colour);
 
     double getDistanceFromAgent() const {
-        return distance_from_agent;
+        return store->distance_from_agent[slot];
     }
     void setRentPaid(double rp) {
-        rent_paid = rp;
+        store->rent_paid[slot] = rp;
     }
     double getRentPaid() const {
-        return rent_paid;
+        return store->rent_paid[slot];
     }
 
     void setSecondOffer(double so) {
-        second_offer = so;
+        store->second_offer[slot] = so;
     }
     double getSecondOffer() const {
-        return second_offer;
+        return store->second_offer[slot];
     }
 
     void setPaymentEntitlement(double pe);
     double getPaymentEntitlement() const {
-        return payment_entitlement;
+        return store->payment_entitlement[slot];
     }
     void setRentedByAgent(int rba) {
-        rented_by_agent = rba;
+        store->rented_by_agent[slot] = rba;
     }
     int getPreviouslyRentedByLegalType() {
-        return previously_rented_by_legal_type;
+        return store->previously_rented_by_legal_type[slot];
     };
     int getRentedByLegalType() {
-        return rented_by_legal_type;
+        return store->rented_by_legal_type[slot];
     };
     int getRentedByAgent() const {
-        return rented_by_agent;
+        return store->rented_by_agent[slot];
     }
     int getPreviouslyRentedByAgent() const {
-        return previously_rented_by_agent;
+        return store->previously_rented_by_agent[slot];
     }
     void setOccupiedByAgent(int oba) {
-        occupied_by_agent = oba;
+        store->occupied_by_agent[slot] = oba;
     }
     int getOccupiedByAgent() const {
-        return occupied_by_agent;
+        return store->occupied_by_agent[slot];
     }
     int getPreviouslyOccupiedByAgent() const {
-        return previously_occupied_by_agent;
+        return store->previously_occupied_by_agent[slot];
     }
     double getDistanceCosts() const {
-        return distance_costs;
+        return store->distance_costs[slot];
     }
     int getCol()const {
-        return PA.col;
+        return store->col[slot];
     }
     int getRow()const {
-        return PA.row;
+        return store->row[slot];
     }
     int getNumber()const {
-        return PA.number;
+        return plot_id;
     }
     bool getNewleyRented() const {
-        return newley_rented;
+        return store->newley_rented[slot];
     }
     void setNewleyRented(bool n) {
-        newley_rented=n;
+        store->newley_rented[slot]=n;
     }
     void setSoilType(int soil_type) {
-        PA.soil_type=soil_type;
-    };
-    void setSoilName(string soil_name) {
-        PA.soil_name=soil_name;
+        store->soil_type[slot]=soil_type;
     };
     int getSoilType() {
-        return PA.soil_type;
-    }
-    string getSoilName() {
-        return PA.soil_name;
+        return store->soil_type[slot];
     }
+    /// name of the soil type, NON_AG for plots which are not farmed
+    string getSoilName();
     void tag() {
-        tagv=true;
+        store->tag[slot]=true;
     }
     void unTag() {
-        tagv=false;
+        store->tag[slot]=false;
     }
     bool getTag() {
-        return tagv;
+        return store->tag[slot];
     }
-    void finish(RegRegionInfo* r);
 
 //DCX
+    /// farm whose farmstead or owned land this plot is, -1 if none
     int getFarmId() {
-        return PA.farm_id;
+        return store->occupied_by_agent[slot];
     }
 };
 
@@ -0,0 +1,156 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// RegPlotComponents.cpp
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include "RegPlotComponents.h"
+#include "RegPlot.h"
+
+RegPlotComponents::RegPlotComponents()
+    : rows(0), cols(0), dirty(true) {
+}
+
+void
+RegPlotComponents::init(int r, int c) {
+    rows = r;
+    cols = c;
+    dirty = true;
+}
+
+int
+RegPlotComponents::owner(RegPlotInfo* p) {
+    if (p->getState()<=0)
+        return -1;
+    if (p->getOccupiedByAgent()!=-1)
+        return p->getOccupiedByAgent();
+    return p->getRentedByAgent();
+}
+
+void
+RegPlotComponents::neighbourIds(int id, int n[4]) const {
+    int row = id%rows;
+    int col = id/rows;
+    n[0] = (row-1+rows)%rows+col*rows;
+    n[1] = row+((col+1)%cols)*rows;
+    n[2] = (row+1)%rows+col*rows;
+    n[3] = row+((col-1+cols)%cols)*rows;
+}
+
+// no path compression, so queries do not change the structure;
+// union by size keeps the trees flat
+int
+RegPlotComponents::find(int id) const {
+    while (parent[id]!=id)
+        id = parent[id];
+    return id;
+}
+
+void
+RegPlotComponents::unite(int a, int b) {
+    a = find(a);
+    b = find(b);
+    if (a==b)
+        return;
+    if (count[a]<count[b])
+        swap(a, b);
+    parent[b] = a;
+    count[a] += count[b];
+}
+
+void
+RegPlotComponents::link(const vector<RegPlotInfo*>& plots, int id) {
+    int n[4];
+    neighbourIds(id, n);
+    int type = plots[id]->getSoilType();
+    for (int k=0;k<4;k++) {
+        if (n[k]!=id && farm_of[n[k]]==farm_of[id]
+                && plots[n[k]]->getSoilType()==type)
+            unite(id, n[k]);
+    }
+}
+
+void
+RegPlotComponents::rebuild(const vector<RegPlotInfo*>& plots) {
+    int n = rows*cols;
+    parent.resize(n);
+    count.assign(n, 1);
+    farm_of.resize(n);
+    for (int id=0;id<n;id++) {
+        parent[id] = id;
+        farm_of[id] = owner(plots[id]);
+    }
+    for (int id=0;id<n;id++)
+        if (farm_of[id]!=-1)
+            link(plots, id);
+    dirty = false;
+}
+
+void
+RegPlotComponents::occupied(const vector<RegPlotInfo*>& plots, RegPlotInfo* p) {
+    if (dirty)
+        return;
+    int id = p->getId();
+    // a plot changing its farm without being released
+    if (farm_of[id]!=-1) {
+        dirty = true;
+        return;
+    }
+    farm_of[id] = owner(p);
+    parent[id] = id;
+    count[id] = 1;
+    if (farm_of[id]!=-1)
+        link(plots, id);
+}
+
+int
+RegPlotComponents::size(const vector<RegPlotInfo*>& plots, RegPlotInfo* p) {
+    if (dirty)
+        rebuild(plots);
+    return count[find(p->getId())];
+}
+
+int
+RegPlotComponents::root(const vector<RegPlotInfo*>& plots, RegPlotInfo* p) {
+    if (dirty)
+        rebuild(plots);
+    return find(p->getId());
+}
+
+int
+RegPlotComponents::neighbours(const vector<RegPlotInfo*>& plots, RegPlotInfo* p, int farm) {
+    if (dirty)
+        rebuild(plots);
+    int id = p->getId();
+    if (farm_of[id]==farm)
+        return count[find(id)]-1;
+    int n[4];
+    int roots[4];
+    int found = 0;
+    int sum = 0;
+    int type = p->getSoilType();
+    neighbourIds(id, n);
+    for (int k=0;k<4;k++) {
+        if (n[k]==id || farm_of[n[k]]!=farm || plots[n[k]]->getSoilType()!=type)
+            continue;
+        int r = find(n[k]);
+        bool seen = false;
+        for (int j=0;j<found;j++)
+            if (roots[j]==r)
+                seen = true;
+        if (!seen) {
+            roots[found++] = r;
+            sum += count[r];
+        }
+    }
+    return sum;
+}
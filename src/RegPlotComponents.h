@@ -0,0 +1,70 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+//---------------------------------------------------------------------------
+// RegPlotComponents.h
+//---------------------------------------------------------------------------
+#ifndef RegPlotComponentsH
+#define RegPlotComponentsH
+
+#include <vector>
+
+using namespace std;
+
+class RegPlotInfo;
+
+/** RegPlotComponents class.
+    @short contiguous plots of the same farm and soil type.
+    Union-find over the plots of the region: a rented, owned or farmstead
+    plot is joined with its neighbours to the north, east, south and west
+    (on the torus) which belong to the same farm and have the same soil
+    type, as identifyContiguousPlot() does. A plot taken by a farm is
+    joined at once; when a farm releases a plot the components are built
+    again at the next query.
+*/
+class RegPlotComponents {
+public:
+    RegPlotComponents();
+    /// no components yet, plot (r,c) is plots[c*rows+r]
+    void init(int rows, int cols);
+    /// p was rented, bought or became a farmstead
+    void occupied(const vector<RegPlotInfo*>& plots, RegPlotInfo* p);
+    /// a plot lost its farm
+    void released() {
+        dirty = true;
+    }
+    /// number of plots in the component of p, p belongs to a farm
+    int size(const vector<RegPlotInfo*>& plots, RegPlotInfo* p);
+    /// representative of the component of p, p belongs to a farm
+    int root(const vector<RegPlotInfo*>& plots, RegPlotInfo* p);
+    /** plots of farm with the soil type of p which are connected to p,
+        p itself not counted; as identifyPlotsSameStateAndFarm()
+    */
+    int neighbours(const vector<RegPlotInfo*>& plots, RegPlotInfo* p, int farm);
+    /// farm of plot p, -1 if p is free or dead
+    static int owner(RegPlotInfo* p);
+private:
+    int rows;
+    int cols;
+    bool dirty;
+    vector<int> parent;
+    vector<int> count;
+    /// farm the plot was joined for, -1 if not in a component
+    vector<int> farm_of;
+    void rebuild(const vector<RegPlotInfo*>& plots);
+    void link(const vector<RegPlotInfo*>& plots, int id);
+    int find(int id) const;
+    void unite(int a, int b);
+    void neighbourIds(int id, int n[4]) const;
+};
+
+#endif
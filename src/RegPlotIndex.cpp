@@ -0,0 +1,181 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// RegPlotIndex.cpp
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include <bit>
+#include "RegPlotIndex.h"
+#include "RegPlot.h"
+
+static int wrap(int x, int n) {
+    return ((x%n)+n)%n;
+}
+
+RegPlotIndex::RegPlotIndex()
+    : rows(0), cols(0), row_words(0), col_words(0) {
+}
+
+void
+RegPlotIndex::init(const vector<RegPlotInfo*>& plots, int r, int c, int types) {
+    rows = r;
+    cols = c;
+    row_words = (cols+63)/64;
+    col_words = (rows+63)/64;
+    row_bits.assign(types, vector<uint64_t>(rows*row_words, 0));
+    col_bits.assign(types, vector<uint64_t>(cols*col_words, 0));
+    for (int j=0;j<cols;j++)
+        for (int i=0;i<rows;i++) {
+            RegPlotInfo* p = plots[j*rows+i];
+            if (p->getState()==0 && p->getSoilType()<types)
+                set(p->getSoilType(), i, j);
+        }
+}
+
+void
+RegPlotIndex::set(int type, int r, int c) {
+    row_bits[type][r*row_words+c/64] |= uint64_t(1)<<(c%64);
+    col_bits[type][c*col_words+r/64] |= uint64_t(1)<<(r%64);
+}
+
+void
+RegPlotIndex::reset(int type, int r, int c) {
+    row_bits[type][r*row_words+c/64] &= ~(uint64_t(1)<<(c%64));
+    col_bits[type][c*col_words+r/64] &= ~(uint64_t(1)<<(r%64));
+}
+
+void
+RegPlotIndex::setFree(RegPlotInfo* p) {
+    if (empty() || p->getSoilType()>=(int)row_bits.size())
+        return;
+    set(p->getSoilType(), p->getRow(), p->getCol());
+}
+
+void
+RegPlotIndex::setOccupied(RegPlotInfo* p) {
+    if (empty() || p->getSoilType()>=(int)row_bits.size())
+        return;
+    reset(p->getSoilType(), p->getRow(), p->getCol());
+}
+
+void
+RegPlotIndex::visit(Search& s, int r, int c) const {
+    int id = c*rows+r;
+    RegPlotInfo* p = (*s.plots)[id];
+    if (p->getSoilType()!=s.type || p->getState()!=0)
+        return;
+    double cost = (*s.cost)(p);
+    if (s.best==NULL || cost<s.best_cost
+            || (cost==s.best_cost && id<s.best->getId())) {
+        s.best = p;
+        s.best_cost = cost;
+    }
+}
+
+void
+RegPlotIndex::scanRow(Search& s, int r, int from, int to) const {
+    const uint64_t* bits = &row_bits[s.type][r*row_words];
+    for (int w=from/64;w<=to/64;w++) {
+        uint64_t word = bits[w];
+        if (w==from/64)
+            word &= ~uint64_t(0)<<(from%64);
+        if (w==to/64 && to%64<63)
+            word &= (uint64_t(1)<<(to%64+1))-1;
+        while (word) {
+            int b = countr_zero(word);
+            word &= word-1;
+            visit(s, r, w*64+b);
+        }
+    }
+}
+
+void
+RegPlotIndex::scanCol(Search& s, int c, int from, int to) const {
+    const uint64_t* bits = &col_bits[s.type][c*col_words];
+    for (int w=from/64;w<=to/64;w++) {
+        uint64_t word = bits[w];
+        if (w==from/64)
+            word &= ~uint64_t(0)<<(from%64);
+        if (w==to/64 && to%64<63)
+            word &= (uint64_t(1)<<(to%64+1))-1;
+        while (word) {
+            int b = countr_zero(word);
+            word &= word-1;
+            visit(s, w*64+b, c);
+        }
+    }
+}
+
+void
+RegPlotIndex::scanRowRange(Search& s, int r, int c, int d) const {
+    if (2*d+1>=cols) {
+        scanRow(s, r, 0, cols-1);
+        return;
+    }
+    int from = wrap(c-d, cols);
+    int to = wrap(c+d, cols);
+    if (from<=to) {
+        scanRow(s, r, from, to);
+    } else {
+        scanRow(s, r, from, cols-1);
+        scanRow(s, r, 0, to);
+    }
+}
+
+void
+RegPlotIndex::scanColRange(Search& s, int c, int r, int d) const {
+    if (2*d+1>=rows) {
+        scanCol(s, c, 0, rows-1);
+        return;
+    }
+    int from = wrap(r-d, rows);
+    int to = wrap(r+d, rows);
+    if (from<=to) {
+        scanCol(s, c, from, to);
+    } else {
+        scanCol(s, c, from, rows-1);
+        scanCol(s, c, 0, to);
+    }
+}
+
+// Ring d holds the plots whose larger distance in rows or columns is d;
+// they are at least d plot lengths away.
+RegPlotInfo*
+RegPlotIndex::findCheapest(const vector<RegPlotInfo*>& plots, int type,
+                           int row, int col, double unit,
+                           const function<double(RegPlotInfo*)>& cost) const {
+    if (empty() || type<0 || type>=(int)row_bits.size())
+        return NULL;
+    Search s;
+    s.plots = &plots;
+    s.type = type;
+    s.cost = &cost;
+    s.best = NULL;
+    s.best_cost = 0;
+    scanRow(s, row, col, col);
+    int dmax = max(rows, cols)/2;
+    for (int d=1;d<=dmax;d++) {
+        if (s.best!=NULL && unit*d>s.best_cost)
+            break;
+        int top = wrap(row-d, rows);
+        int bottom = wrap(row+d, rows);
+        scanRowRange(s, top, col, d);
+        if (bottom!=top)
+            scanRowRange(s, bottom, col, d);
+        int left = wrap(col-d, cols);
+        int right = wrap(col+d, cols);
+        scanColRange(s, left, row, d-1);
+        if (right!=left)
+            scanColRange(s, right, row, d-1);
+    }
+    return s.best;
+}
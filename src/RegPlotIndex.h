@@ -0,0 +1,88 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+//---------------------------------------------------------------------------
+// RegPlotIndex.h
+//---------------------------------------------------------------------------
+#ifndef RegPlotIndexH
+#define RegPlotIndexH
+
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+using namespace std;
+
+class RegPlotInfo;
+
+/** RegPlotIndex class.
+    @short free plots of the region per soil type for the plot search.
+    For each soil type a bitmap per row and per column marks the plots
+    which are free. The region sets the bits of released plots by
+    setFree() and removes those of occupied plots by setOccupied();
+    findCheapest() only reads the bitmaps, so the farms may search
+    concurrently while no plot changes hands. It searches rings of
+    growing distance around the farmstead on the torus and stops as soon
+    as the distance costs of the next ring exceed the best plot found.
+*/
+class RegPlotIndex {
+public:
+    RegPlotIndex();
+    /// marks the free plots of the region, plot (r,c) is plots[c*rows+r]
+    void init(const vector<RegPlotInfo*>& plots, int rows, int cols, int types);
+    bool empty() const {
+        return row_bits.empty();
+    }
+    /// plot p became free
+    void setFree(RegPlotInfo* p);
+    /// plot p was rented, owned or set dead
+    void setOccupied(RegPlotInfo* p);
+    /** free plot of type with the lowest costs for a farmstead at (row,col),
+        of equal costs the one with the lowest id
+        @param unit distance costs per plot length
+        @param cost costs of a plot, not below unit times its distance
+        @return NULL if there is no free plot of type
+    */
+    RegPlotInfo* findCheapest(const vector<RegPlotInfo*>& plots, int type,
+                              int row, int col, double unit,
+                              const function<double(RegPlotInfo*)>& cost) const;
+private:
+    int rows;
+    int cols;
+    int row_words;
+    int col_words;
+    /// bit c of row r at row_bits[type][r*row_words+c/64]
+    vector<vector<uint64_t> > row_bits;
+    /// bit r of column c at col_bits[type][c*col_words+r/64]
+    vector<vector<uint64_t> > col_bits;
+
+    struct Search {
+        const vector<RegPlotInfo*>* plots;
+        int type;
+        const function<double(RegPlotInfo*)>* cost;
+        RegPlotInfo* best;
+        double best_cost;
+    };
+    void set(int type, int r, int c);
+    void reset(int type, int r, int c);
+    void visit(Search& s, int r, int c) const;
+    /// plots of row r in columns from..to, to<cols
+    void scanRow(Search& s, int r, int from, int to) const;
+    /// plots of column c in rows from..to, to<rows
+    void scanCol(Search& s, int c, int from, int to) const;
+    /// plots of row r in the columns c-d..c+d on the torus
+    void scanRowRange(Search& s, int r, int c, int d) const;
+    /// plots of column c in the rows r-d..r+d on the torus
+    void scanColRange(Search& s, int c, int r, int d) const;
+};
+
+#endif
@@ -0,0 +1,48 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+
+// RegPlotRings.cpp
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include "RegPlotRings.h"
+
+RegPlotRings::RegPlotRings()
+    : rows(0), cols(0) {
+}
+
+// Every row and column offset occurs once: dr in -(rows-1)/2..rows/2,
+// so |dr| is the distance in rows on the torus, the same for dc.
+// The squared distances are integers and sort exactly. Plots of equal
+// distance follow in the order of the loops, by column offset, then by
+// row offset. The sorted per-farmstead lists of FAST_PLOT_SEARCH before
+// had them in the order the quicksort left them, which depends on the
+// soil types of the region, so a farm may now take another plot at
+// the same distance.
+void
+RegPlotRings::init(int r, int c) {
+    rows = r;
+    cols = c;
+    offsets.clear();
+    offsets.reserve(rows*cols);
+    for (int dc=-(cols-1)/2;dc<=cols/2;dc++)
+        for (int dr=-(rows-1)/2;dr<=rows/2;dr++) {
+            Offset o;
+            o.dr = dr;
+            o.dc = dc;
+            offsets.push_back(o);
+        }
+    stable_sort(offsets.begin(), offsets.end(),
+                [](const Offset& a, const Offset& b) {
+                    return a.dr*a.dr+a.dc*a.dc < b.dr*b.dr+b.dc*b.dc;
+                });
+}
@@ -0,0 +1,63 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+
+//---------------------------------------------------------------------------
+// RegPlotRings.h
+//---------------------------------------------------------------------------
+#ifndef RegPlotRingsH
+#define RegPlotRingsH
+
+#include <vector>
+
+using namespace std;
+
+/** RegPlotRings class.
+    @short plots of the region in the order of their distance to a plot.
+    Offsets of rows and columns on the torus, sorted by distance, of
+    equal distance by column and row offset. The table is the same for
+    all plots, so a farm only keeps its position in it; the k-th nearest
+    plot of a farmstead is found with plotAt(k,...).
+*/
+class RegPlotRings {
+public:
+    RegPlotRings();
+    /// offsets of all plots of a region, plot (r,c) is plots[c*rows+r]
+    void init(int rows, int cols);
+    bool empty() const {
+        return offsets.empty();
+    }
+    /// number of plots in the region
+    unsigned int size() const {
+        return offsets.size();
+    }
+    /// id of the k-th nearest plot to the plot at (row,col), k=0 is the plot itself
+    int plotAt(unsigned int k, int row, int col) const {
+        int r = row+offsets[k].dr;
+        int c = col+offsets[k].dc;
+        if (r<0) r += rows;
+        else if (r>=rows) r -= rows;
+        if (c<0) c += cols;
+        else if (c>=cols) c -= cols;
+        return c*rows+r;
+    }
+private:
+    struct Offset {
+        int dr;
+        int dc;
+    };
+    int rows;
+    int cols;
+    vector<Offset> offsets;
+};
+
+#endif
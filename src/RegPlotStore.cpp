@@ -0,0 +1,71 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// RegPlotStore.cpp
+//---------------------------------------------------------------------------
+#include "RegPlotStore.h"
+#include "RegPlot.h"
+
+RegPlotStore::RegPlotStore()
+    : g(NULL), region(NULL) {
+}
+
+void
+RegPlotStore::init(RegGlobalsInfo* G, int rows, const vector<int>& order, vector<RegPlotInfo*>& plots) {
+    int n = order.size();
+    id = order;
+    slot.resize(n);
+    row.resize(n);
+    col.resize(n);
+    for (int s=0;s<n;s++) {
+        slot[id[s]] = s;
+        row[s] = id[s]%rows;
+        col[s] = id[s]/rows;
+    }
+    state.assign(n, 0);
+    soil_type.assign(n, 0);
+    contract_length.assign(n, 0);
+    rented_by_agent.assign(n, -1);
+    previously_rented_by_agent.assign(n, -1);
+    occupied_by_agent.assign(n, -1);
+    previously_occupied_by_agent.assign(n, -1);
+    rented_by_legal_type.assign(n, -1);
+    previously_rented_by_legal_type.assign(n, -1);
+    rent_paid.assign(n, -1);
+    second_offer.assign(n, -1);
+    previously_paid_by_agent.assign(n, 0);
+    payment_entitlement.assign(n, 0);
+    initial_payment_entitlement.assign(n, 0);
+    distance_from_agent.assign(n, -1);
+    distance_costs.assign(n, 0);
+    carbon.assign(n, 0);
+    tacs.assign(n, 0);
+    paid_tacs.assign(n, 0);
+    newley_rented.assign(n, false);
+    tag.assign(n, false);
+    update.assign(n, false);
+    contiguous_plot.clear();
+    bind(G, plots);
+}
+
+void
+RegPlotStore::bind(RegGlobalsInfo* G, vector<RegPlotInfo*>& plots) {
+    g = G;
+    region = &plots;
+    handles.v.clear();
+    handles.v.reserve(size());
+    for (unsigned int s=0;s<size();s++)
+        handles.v.push_back(RegPlotInfo(this, id[s], s));
+    plots.resize(size());
+    for (unsigned int s=0;s<size();s++)
+        plots[id[s]] = &handles.v[s];
+}
@@ -0,0 +1,104 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+//---------------------------------------------------------------------------
+// RegPlotStore.h
+//---------------------------------------------------------------------------
+#ifndef RegPlotStoreH
+#define RegPlotStoreH
+
+#include <vector>
+#include <unordered_map>
+
+using namespace std;
+
+class RegGlobalsInfo;
+class RegPlotInfo;
+
+/** RegPlotStore class.
+    @short the data of all plots of a region, one column per attribute.
+    A RegPlotInfo is a handle of the store, the plot id and the slot of
+    the plot in the columns; its accessors read and write the columns at
+    the slot. Sweeps over the region thus read only the columns they need.
+    The region decides the order of the slots. Copying the store copies the data of all
+    plots, the region backup is such a copy; restoring it leaves the
+    handles, which the farms point to, in place.
+*/
+class RegPlotStore {
+public:
+    RegPlotStore();
+    /** idle plots of soil type 0, plot (r,c) has the id c*rows+r;
+        plots[id] is set to the handle of plot id
+        @param order plot ids in the order of their slots
+    */
+    void init(RegGlobalsInfo* G, int rows, const vector<int>& order, vector<RegPlotInfo*>& plots);
+    /// after a copy: handles of this store in plots, globals G
+    void bind(RegGlobalsInfo* G, vector<RegPlotInfo*>& plots);
+    unsigned int size() const {
+        return state.size();
+    }
+
+    RegGlobalsInfo* g;
+    /// plot vector of the region, for the neighbour searches
+    vector<RegPlotInfo*>* region;
+    /// slot of a plot by plot id
+    vector<int> slot;
+    /// plot id by slot
+    vector<int> id;
+
+    vector<int> row;
+    vector<int> col;
+    /** -1: dead plot, 0: idle plot, 1: rented plot, 2: farmstead,
+        3: owned land
+    */
+    vector<signed char> state;
+    vector<int> soil_type;
+    vector<int> contract_length;
+    vector<int> rented_by_agent;
+    vector<int> previously_rented_by_agent;
+    vector<int> occupied_by_agent;
+    vector<int> previously_occupied_by_agent;
+    vector<signed char> rented_by_legal_type;
+    vector<signed char> previously_rented_by_legal_type;
+    vector<double> rent_paid;
+    vector<double> second_offer;
+    vector<double> previously_paid_by_agent;
+    vector<double> payment_entitlement;
+    vector<double> initial_payment_entitlement;
+    vector<double> distance_from_agent;
+    vector<double> distance_costs;
+    vector<double> carbon;
+    vector<double> tacs;
+    vector<double> paid_tacs;
+    vector<char> newley_rented;
+    vector<char> tag;
+    vector<char> update;
+    /** plot ids found by identifyContiguousPlot() from a plot until its
+        clearContiguousPlot(), by plot id; only few plots have one
+    */
+    unordered_map<int, vector<int> > contiguous_plot;
+private:
+    /** the handles stay with their store: a copy has none until bind(),
+        an assignment only copies the data of the plots
+    */
+    struct Handles {
+        vector<RegPlotInfo> v;
+        Handles() {}
+        Handles(const Handles&) {}
+        Handles& operator=(const Handles&) {
+            return *this;
+        }
+    };
+    Handles handles;
+};
+
+#endif
@@ -224,6 +224,7 @@ RegProductList::RegProductList(RegGlobalsInfo* G,vector<RegProductInfo>& P)
     }
     use_price_expectation=true;
     units_produced_for_prem_calc.resize((*products).size());
+    stamp=g->newLinkStamp();
 }
 
 RegProductList::RegProductList(RegProductList& rh,RegGlobalsInfo* G,vector<RegProductInfo>& P)
@@ -238,6 +239,7 @@ RegProductList::RegProductList(RegProductList& rh,RegGlobalsInfo* G,vector<RegPr
     use_price_expectation=rh.use_price_expectation;
     units_produced_for_prem_calc=rh.units_produced_for_prem_calc;
     fixed_reference_production=rh.fixed_reference_production;
+    stamp=g->newLinkStamp();
 }
 
 double
@@ -318,6 +320,7 @@ RegProductList::updateCosts(double mc) {
             var_costs_old[i]=var_costs[i];
         }
     }
+    stamp=g->newLinkStamp();
 }
 void
 RegProductList::changeVarCosts(double f, int investgroup) {
@@ -348,6 +351,7 @@ RegProductList::restoreProductList() {
         var_costs[i] = var_costs_old[i];
         units_produced[i]=units_produced_old[i];
     }
+    stamp=g->newLinkStamp();
 }
 double
 RegProductList::getVarCostsOfNumber(int n) {
@@ -357,6 +361,7 @@ RegProductList::getVarCostsOfNumber(int n) {
 void
 RegProductList::setVarCostsOfNumber(int n, double v) {
     var_costs[n] = v;
+    stamp=g->newLinkStamp();
 }
 
 double
@@ -404,6 +409,7 @@ RegProductList::getVarCostsOfType(int n) {
 void
 RegProductList::setVarCostsOfType(int n,double v) {
     var_costs[n] = v;
+    stamp=g->newLinkStamp();
 }
 double
 RegProductList::getPriceOfType(int n) {
@@ -480,6 +486,8 @@ RegProductList::setUsePriceExpectation(bool set) {
     else
         changed=true;
     use_price_expectation=set;
+    if (changed)
+        stamp=g->newLinkStamp();
     return changed;
 }
 
@@ -318,7 +318,12 @@ private:
     vector< list<double> > units_produced_for_prem_calc;
     vector<double> fixed_reference_production;
     RegProductList* obj_backup;
+    /// link stamp, renewed whenever var_costs or use_price_expectation change
+    unsigned long stamp;
 public:
+    unsigned long getStamp() const {
+        return stamp;
+    }
 	//soil service 
 	double getNoptOfNumber(int, RegFarmInfo*);
 	double getYieldOfNumber(int, RegFarmInfo*);
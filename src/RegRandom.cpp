@@ -0,0 +1,93 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// RegRandom.cpp
+//---------------------------------------------------------------------------
+#include "RegRandom.h"
+
+RegPhilox::RegPhilox(uint32_t seed, uint32_t stream, uint32_t farm,
+                     uint32_t iteration, uint32_t draw)
+    : pos(4) {
+    key[0] = seed;
+    key[1] = stream;
+    ctr[0] = farm;
+    ctr[1] = iteration;
+    ctr[2] = draw;
+    ctr[3] = 0;
+}
+
+RegPhilox::result_type
+RegPhilox::operator()() {
+    if (pos==4) {
+        block(key, ctr, out);
+        ctr[3]++;
+        pos = 0;
+    }
+    return out[pos++];
+}
+
+// FNV-1a
+uint32_t
+RegPhilox::streamKey(const string& name) {
+    uint32_t h = 2166136261u;
+    for (unsigned int i=0;i<name.size();i++) {
+        h ^= (unsigned char)name[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// constants and rounds as in Random123 philox4x32-10
+void
+RegPhilox::block(const uint32_t k[2], const uint32_t c[4], uint32_t o[4]) {
+    const uint32_t M0 = 0xD2511F53u;
+    const uint32_t M1 = 0xCD9E8D57u;
+    const uint32_t W0 = 0x9E3779B9u;
+    const uint32_t W1 = 0xBB67AE85u;
+    uint32_t k0 = k[0];
+    uint32_t k1 = k[1];
+    uint32_t x0 = c[0], x1 = c[1], x2 = c[2], x3 = c[3];
+    for (int r=0;r<10;r++) {
+        uint64_t p0 = (uint64_t)M0*x0;
+        uint64_t p1 = (uint64_t)M1*x2;
+        uint32_t y0 = (uint32_t)(p1>>32)^x1^k0;
+        uint32_t y1 = (uint32_t)p1;
+        uint32_t y2 = (uint32_t)(p0>>32)^x3^k1;
+        uint32_t y3 = (uint32_t)p0;
+        x0 = y0;
+        x1 = y1;
+        x2 = y2;
+        x3 = y3;
+        k0 += W0;
+        k1 += W1;
+    }
+    o[0] = x0;
+    o[1] = x1;
+    o[2] = x2;
+    o[3] = x3;
+}
+
+RegRandomStreams::RegRandomStreams(int f)
+    : farm(f) {
+}
+
+uint32_t
+RegRandomStreams::next(int stream, int iteration) {
+    if (stream>=(int)draws.size())
+        draws.resize(stream+1, make_pair(-1, 0u));
+    pair<int, uint32_t>& d = draws[stream];
+    if (d.first!=iteration) {
+        d.first = iteration;
+        d.second = 0;
+    }
+    return d.second++;
+}
@@ -0,0 +1,81 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+//---------------------------------------------------------------------------
+// RegRandom.h
+//---------------------------------------------------------------------------
+#ifndef RegRandomH
+#define RegRandomH
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/** RegPhilox class.
+    @short counter-based random engine (Philox4x32-10, Salmon et al. 2011).
+    A number is a function of the key and the counter only, there is no
+    state carried from one draw to the next. The key is made of the seed
+    and the name of the stream, the counter of the farm, the iteration
+    and the number of the draw. The engine of one draw returns the words
+    of the blocks (farm,iteration,draw,0), (farm,iteration,draw,1), ...
+    so a distribution may ask for as many numbers as it needs.
+*/
+class RegPhilox {
+public:
+    typedef uint32_t result_type;
+    static constexpr result_type min() {
+        return 0;
+    }
+    static constexpr result_type max() {
+        return 0xffffffffu;
+    }
+    RegPhilox(uint32_t seed, uint32_t stream, uint32_t farm,
+              uint32_t iteration, uint32_t draw);
+    result_type operator()();
+    /// key word of a stream name
+    static uint32_t streamKey(const string& name);
+    /// 10 rounds of Philox4x32 on ctr
+    static void block(const uint32_t key[2], const uint32_t ctr[4], uint32_t out[4]);
+private:
+    uint32_t key[2];
+    uint32_t ctr[4];
+    uint32_t out[4];
+    int pos;
+};
+
+/** RegRandomStreams class.
+    @short numbers of the draws of one farm from the counter-based streams.
+    Draws are counted per stream and iteration, so the numbers a farm gets
+    do not depend on the draws of other farms. The streams of a farm are
+    only used by the thread working on the farm. Farm -1 draws for the
+    region and the sector.
+*/
+class RegRandomStreams {
+public:
+    RegRandomStreams(int farm=-1);
+    int getFarm() const {
+        return farm;
+    }
+    void setFarm(int f) {
+        farm = f;
+    }
+    /// number of the next draw from stream in iteration, from 0 in every iteration
+    uint32_t next(int stream, int iteration);
+private:
+    int farm;
+    /// iteration and draws so far per stream
+    vector<pair<int, uint32_t> > draws;
+};
+
+#endif
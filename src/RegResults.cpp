@@ -453,9 +453,9 @@ RegSectorResultsInfo::economicLandRent(double refincome){
     double bcinterest = (total_lt_interest_costs
                          + total_st_interest_costs);
     double ecinterest = ((total_equity_capital-total_land_assets-total_ecchange+total_withdrawal)*g->EQ_INTEREST);
-    double quota = ((getTotalUnitsProduced(g->stdNameIndexs["MILK"])*g->MILKPROD
-                     + getTotalUnitsProduced(g->stdNameIndexs["LETQUOTA"])
-                     - getTotalUnitsProduced(g->stdNameIndexs["GETQUOTA"])
+    double quota = ((getTotalUnitsProduced(g->getStdNameIndex("MILK"))*g->MILKPROD
+                     + getTotalUnitsProduced(g->getStdNameIndex("LETQUOTA"))
+                     - getTotalUnitsProduced(g->getStdNameIndex("GETQUOTA"))
                     ) * g->QUOTA_PRICE);
 
     total_ec_land_rent =  hhincome
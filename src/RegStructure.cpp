@@ -12,6 +12,8 @@
 
 #include <stdlib.h>
 #include <time.h>
+#include <math.h>
+#include <algorithm>
 
 #include "RegStructure.h"
 #include "RegFarm.h"
@@ -20,11 +22,12 @@
 
 using namespace std;
 
-typedef vector<RegPlotInfo* >::iterator iter;
-
 RegRegionInfo::RegRegionInfo(RegGlobalsInfo* G) :g(G) {
     obj_backup=NULL;
     flat_copy=false;
+    released_plots=0;
+    layout=0;
+    counted_layout=-1;
     for (int i=0;i<g->NO_OF_SOIL_TYPES;i++) {
         free_plots_of_type.push_back(0);
         plots_of_type.push_back(0);
@@ -40,13 +43,8 @@ RegRegionInfo::RegRegionInfo(RegGlobalsInfo* G) :g(G) {
 RegRegionInfo::RegRegionInfo(const RegRegionInfo& rh,RegGlobalsInfo* G):g(G) {
     flat_copy=false;
     obj_backup=NULL;
-    plots.resize(rh.plots.size());
-    for (unsigned int i = 0;i<rh.plots.size();i++) { // for each column
-        plots[i]=new RegPlotInfo(*(rh.plots[i]),g,plots);
-    }
-    for (unsigned int i = 0;i<rh.plots.size();i++) { // for each column
-        plots[i]->finish(*(rh.plots[i]));
-    }
+    plot_store=rh.plot_store;
+    plot_store.bind(g,plots);
     contiguous_plots=rh.contiguous_plots;
     free_plots_of_type=rh.free_plots_of_type;
     plots_of_type=rh.plots_of_type;
@@ -54,26 +52,21 @@ RegRegionInfo::RegRegionInfo(const RegRegionInfo& rh,RegGlobalsInfo* G):g(G) {
     average_new_rent_of_type=rh.average_new_rent_of_type;
     exp_average_rent_of_type=rh.exp_average_rent_of_type;
     exp_average_new_rent_of_type=rh.exp_average_new_rent_of_type;
-    free_plots.resize(rh.free_plots.size());
-    for (unsigned int i=0;i<rh.free_plots.size();i++) {
-        free_plots[i]=plots[rh.free_plots[i]->getId()];
-    }
+    free_plots=rh.free_plots;
+    free_plots.remap(plots);
     total_tacs=rh.total_tacs;
     fix_tacs=rh.fix_tacs;
     var_tacs=rh.var_tacs;
+    released_plots=rh.released_plots;
+    plot_index=rh.plot_index;
+    rings=rh.rings;
+    components=rh.components;
+    layout=rh.layout;
+    counted_layout=rh.counted_layout;
 }
 
-// destroy the region
+// destroy the region, the plots are destroyed with plot_store
 RegRegionInfo::~RegRegionInfo() {
-    if (!flat_copy) {
-        for (iter i = plots.begin();
-                i != plots.end();
-                i++) {
-            // delete each plot in the vector
-            delete *i;
-        }
-    }
-    // clear the vector
     plots.clear();
     if (obj_backup) delete obj_backup;
 }
@@ -90,18 +83,15 @@ RegRegionInfo::cPoT(int t) {
 }
 
 int RegRegionInfo::getRandom_contractLength() {
-	string name = "CONTRACTLENGTH";
-	return g->getRandomInt(name,g->uni_int_distrib_contractLength);
+	return g->getRandomInt(RAND_GEN::CONTRACTLENGTH,g->uni_int_distrib_contractLength);
 }
 
 int RegRegionInfo::getRandom_freePlot_initLand() {
-	string name = "FREEPLOT_INITLAND";
-	return g->getRandomInt(name,g->uni_int_distrib_freePlot_initLand);
+	return g->getRandomInt(RAND_GEN::FREEPLOT_INITLAND,g->uni_int_distrib_freePlot_initLand);
 }
 
 int RegRegionInfo::getRandom_freePlot_rentPlot() {
-	string name = "FREEPLOT_RENTPLOT";
-	return g->getRandomInt(name,g->uni_int_distrib_freePlot_rentPlot);
+	return g->getRandomInt(RAND_GEN::FREEPLOT_RENTPLOT,g->uni_int_distrib_freePlot_rentPlot);
 }
 
 void
@@ -120,12 +110,9 @@ void
 RegRegionInfo::occupyPlot(RegPlotInfo* p,RegFarmInfo* f) {
     p->setDistanceFromAgent(p->calculateDistance(f->getFarmPlot()));
     decreaseFreePlotsOfType(p->getSoilType());
-    unsigned int i;
-    for ( i=0;i<free_plots.size();i++) {
-        if (free_plots[i]==p) break;
-    }
-    vector<RegPlotInfo*>::iterator del=free_plots.begin()+i;
-    free_plots.erase(del);
+    free_plots.remove(p);
+    plot_index.setOccupied(p);
+    components.occupied(plots,p);
 }
 
 void
@@ -145,7 +132,10 @@ RegRegionInfo::releasePlot(RegPlotInfo* p) {
     increaseFreePlotsOfType(p->getSoilType());
     p->setState(0, 0, 0);
     p->setDistanceFromAgent(0);
-    free_plots.push_back(p);
+    free_plots.add(p);
+    released_plots++;
+    plot_index.setFree(p);
+    components.released();
 }
 
 // initialise region
@@ -157,21 +147,15 @@ RegRegionInfo::initialisation() {
     }
     int non_ag_plots=static_cast<int>(g->NON_AG_LANDINPUT/g->PLOT_SIZE);
 
-    plots.resize(g->NO_ROWS * g->NO_COLS);
-    free_plots.resize(g->NO_ROWS * g->NO_COLS);
+    free_plots.init(g->NO_ROWS * g->NO_COLS);
     
-	// create plots
+	// create plots, inititally all land is set to arable land
+    plot_store.init(g, g->NO_ROWS, plotOrder(), plots);
     int index;
     for (int c = 0; c < g->NO_COLS; c++) { // for each column
         for (int r = 0; r < g->NO_ROWS; r++) { //... and row
             index = c * g->NO_ROWS + r;    // create index number
-            // ... and call setup function for each plot
-            plots[index]=new RegPlotInfo(g,index,c,r,plots);
-            // inititally all land is set to arable land
-            plots[index]->setSoilType(0);
-            plots[index]->setSoilName(g->NAMES_OF_SOIL_TYPES[0]);
-            plots[index]->setId(index);
-            free_plots[index]=plots[index];
+            free_plots.add(plots[index]);
         }
     }
     
@@ -179,18 +163,49 @@ RegRegionInfo::initialisation() {
     for (int i=0;i<non_ag_plots;i++) {
         RegPlotInfo* free=getRandomFreePlotOfType(0);
         free->setSoilType(type);
-        free->setSoilName("NON_AG");
         //    plots[index]->setState(-1,NULL,0);
     }
     for (int i=0;i<g->NO_OF_SOIL_TYPES;i++) {
         for (int j=0;j<plots_of_type[i];j++) {
             RegPlotInfo* free=getRandomFreePlotOfType(0);
             free->setSoilType(i);
-            free->setSoilName(g->NAMES_OF_SOIL_TYPES[i]);
         }
     }
     countFreePlotsOfType();
     countPlotsOfType();
+    plot_index.init(plots, g->NO_ROWS, g->NO_COLS, g->NO_OF_SOIL_TYPES);
+    components.init(g->NO_ROWS, g->NO_COLS);
+    layout++;
+}
+
+uint64_t
+RegRegionInfo::zOrder(int row, int col) {
+    uint64_t z = 0;
+    for (int b = 0; b < 32; b++) {
+        z |= uint64_t((row >> b) & 1) << (2 * b);
+        z |= uint64_t((col >> b) & 1) << (2 * b + 1);
+    }
+    return z;
+}
+
+// With ZORDER_PLOT_LAYOUT the data of the plots are stored along the
+// Z-order curve, so that plots which are close in the region are mostly
+// close in memory as well. The id of a plot and its index in plots stay
+// c*NO_ROWS+r, only the store translates it.
+vector<int>
+RegRegionInfo::plotOrder() const {
+    int n = g->NO_ROWS * g->NO_COLS;
+    vector<int> order(n);
+    for (int i = 0; i < n; i++)
+        order[i] = i;
+    if (g->ZORDER_PLOT_LAYOUT) {
+        vector<uint64_t> z(n);
+        for (int i = 0; i < n; i++)
+            z[i] = zOrder(i % g->NO_ROWS, i / g->NO_ROWS);
+        sort(order.begin(), order.end(),
+             [&z](int a, int b) { return z[a] < z[b]; });
+    }
+    return order;
 }
 
 void
@@ -226,6 +241,7 @@ void RegRegionInfo::countFreePlotsOfType() {
 }
 
 void RegRegionInfo::setIdlePlotsDead() {
+    layout++;
     int index=0;
     for (int c = 0; c < g->NO_COLS; c++) { // for each column
         for (int r = 0; r < g->NO_ROWS; r++) { //... and row
@@ -234,19 +250,12 @@ void RegRegionInfo::setIdlePlotsDead() {
             // of free plots
             if (plots[index]->getState()==0) {
                 decreaseFreePlotsOfType(plots[index]->getSoilType());
+                plot_index.setOccupied(plots[index]);
                 // set all plots that are neither arable nor grassland
                 // dead, ie. colour them black
                 plots[index]->setState(-1,NULL,0);
                 plots[index]->setSoilType(g->NO_OF_SOIL_TYPES);
-                plots[index]->setSoilName("NON_AG");
-                unsigned int i;
-                for (i=0;i<free_plots.size();i++) {
-                    if (free_plots[i]==plots[index]) {
-                      break;
-                    }
-                }
-                vector<RegPlotInfo*>::iterator del=free_plots.begin()+i;
-                free_plots.erase(del);
+                free_plots.remove(plots[index]);
             }
         }
     }
@@ -255,18 +264,20 @@ void RegRegionInfo::setIdlePlotsDead() {
     /// set n of dead plots to idle plots of soil type t
 
 void RegRegionInfo::setDeadPlotsToType(int n,int t) {
+  layout++;
   if(plots_of_type[g->NO_OF_SOIL_TYPES]<n)
     n=plots_of_type[g->NO_OF_SOIL_TYPES];
 
   for(int i=0;i<n;i++) {
     RegPlotInfo* free=getRandomPlotOfType(g->NO_OF_SOIL_TYPES);
     free->setSoilType(t);
-    free->setSoilName(g->NAMES_OF_SOIL_TYPES[t]);
     free->setState(0,NULL,0);
     increaseFreePlotsOfType(t);
     plots_of_type[t]++;
     plots_of_type[g->NO_OF_SOIL_TYPES]--;
-    free_plots.push_back(free);
+    free_plots.add(free);
+    released_plots++;
+    plot_index.setFree(free);
  }
 }
 
@@ -393,7 +404,7 @@ RegRegionInfo::getRandomPlotOfType(int type) {
     RegPlotInfo* p;
     do {
         test=false;
-		int randplot = randlong() % (g->NO_COLS * g->NO_ROWS);
+		int randplot = g->mtrand.randlong() % (g->NO_COLS * g->NO_ROWS);
 		//cout << randplot << "\t";
 
         p=plots[randplot];
@@ -416,7 +427,7 @@ RegRegionInfo::getRandomFreePlot() {
 		//cout << r << "\t";
 
 		r = r % t;
-		return free_plots[r];
+		return free_plots.at(r);
     }
 }
 void
@@ -526,9 +537,14 @@ int RegRegionInfo::getContiguousPlotsOfType(int type) const{
     return contiguous_plots[type].size();
 }
 
+// the contiguous plots of the region only change with the soil types
+// and dead plots
 void RegRegionInfo::countContiguousPlots() {
     vector<RegPlotInfo* >::iterator i;
     clearTagsForContiguousPlots();
+    if (counted_layout==layout)
+        return;
+    counted_layout=layout;
     initVectorOfContiguousPlots();
     i=plots.begin();
     int c=0;
@@ -575,27 +591,111 @@ void RegRegionInfo::initVectorOfContiguousPlots() {
         contiguous_plots.push_back(temp);
     }
 }
-void RegRegionInfo::initPlotSearch() {
-    if (g->FAST_PLOT_SEARCH) {
-        for (int i = 0; i < g->NO_COLS*g->NO_ROWS; i++) {
-            plots[i]->finish(this);
+bool
+RegRegionInfo::usePlotIndex() const {
+    if (!g->WEIGHTED_PLOT_SEARCH || g->TRANSPORT_COSTS<0 || plot_index.empty())
+        return false;
+    // initially the costs are the distance costs
+    if (g->INITIALISATION)
+        return true;
+    if (!g->INDEXED_PLOT_SEARCH || g->SWEDEN || g->ENV_MODELING)
+        return false;
+    return !g->USE_TC_FRAMEWORK || (g->FIXED_BONUS_VALUE>=0 && g->VARIABLE_BONUS_VALUE>=0);
+}
+
+RegPlotInformationInfo
+RegRegionInfo::findMostPreferablePlotOfType(RegPlotInfo* farm_plot, int type, RegFarmInfo* farm) {
+    if (!usePlotIndex()) {
+        if (!g->WEIGHTED_PLOT_SEARCH && !rings.empty() && farm->hasPlotPointer()) {
+            RegPlotInformationInfo pi;
+            pi.plot=findFreePlotOfType(farm, type);
+            if (pi.plot!=NULL) {
+                pi.tc=farm_plot->calculateDistanceCosts(pi.plot);
+                pi.pe=pi.plot->getPaymentEntitlement();
+            }
+            return pi;
+        }
+        if (g->INITIALISATION)
+            return farm_plot->findMostPreferablePlotOfType(type, farm);
+        return farm_plot->findMostPreferablePlotOfType(type, farm->getFarmsteadSearch());
+    }
+    double unit=sqrt(g->PLOT_SIZE)/10*g->TRANSPORT_COSTS;
+    RegPlotInfo* p=plot_index.findCheapest(plots, type, farm_plot->getRow(), farm_plot->getCol(), unit,
+        [&](RegPlotInfo* q) { return farm_plot->calculateValue(q, farm).costs(); });
+    if (p==NULL)
+        return RegPlotInformationInfo();
+    return farm_plot->calculateValue(p, farm);
+}
+
+// A farm rarely looks beyond its nearest plots, so the plots are
+// enumerated from the shared table instead of keeping a sorted list of
+// all plots per farm. Plots of other soil types or taken ones are skipped;
+// plots released behind the cursor are found after resetPlotPointer().
+RegPlotInfo*
+RegRegionInfo::findFreePlotOfType(RegFarmInfo* farm, int type) {
+    int row=farm->getFarmPlot()->getRow();
+    int col=farm->getFarmPlot()->getCol();
+    for (unsigned int k=farm->getPlotPointer(type);k<rings.size();k++) {
+        RegPlotInfo* p=plots[rings.plotAt(k, row, col)];
+        if (p->getSoilType()==type && p->getState()==0) {
+            farm->setPlotPointer(type, k);
+            return p;
         }
     }
+    farm->setPlotPointer(type, rings.size());
+    return NULL;
 }
+
+// setTacs() leaves plots tagged, the search of identifyContiguousPlot()
+// skips them; in this case the search is kept
+int
+RegRegionInfo::identifyPlotsSameStateAndFarm(RegPlotInfo* p, int farm) {
+    if (g->USE_TC_FRAMEWORK || farm<0)
+        return p->identifyPlotsSameStateAndFarm(farm);
+    return components.neighbours(plots, p, farm);
+}
+
+void RegRegionInfo::initPlotSearch(const list<RegFarmInfo*>& farms) {
+    if (g->FAST_PLOT_SEARCH) {
+        if (rings.empty())
+            rings.init(g->NO_ROWS, g->NO_COLS);
+        for (list<RegFarmInfo*>::const_iterator f=farms.begin();f!=farms.end();f++)
+            (*f)->initPlotSearch();
+    }
+}
+// the copy holds the data of all plots in its plot_store
 void
 RegRegionInfo::backup() {
     obj_backup=new RegRegionInfo(*this);
     obj_backup->flat_copy=true;
-    for (unsigned int i=0;i<plots.size();i++) {
-        plots[i]->backup();
-    }
 }
+// only data is copied back: plots keeps the handles of this region, which
+// the farms point to, plot_store keeps its handles and its region, and the
+// free plot set is pointed at plots again
 void
 RegRegionInfo::restore() {
-    RegRegionInfo* tmp=obj_backup;
-    *this=*obj_backup;
-    obj_backup=tmp;
-    for (unsigned int i=0;i<plots.size();i++) {
-        plots[i]->restore();
-    }
+    const RegRegionInfo& rh=*obj_backup;
+    vector<RegPlotInfo*>* region=plot_store.region;
+    plot_store=rh.plot_store;
+    plot_store.region=region;
+    contiguous_plots=rh.contiguous_plots;
+    free_plots_of_type=rh.free_plots_of_type;
+    plots_of_type=rh.plots_of_type;
+    average_rent_of_type=rh.average_rent_of_type;
+    exp_average_rent_of_type=rh.exp_average_rent_of_type;
+    average_rent=rh.average_rent;
+    average_new_rent_of_type=rh.average_new_rent_of_type;
+    exp_average_new_rent_of_type=rh.exp_average_new_rent_of_type;
+    average_new_rent=rh.average_new_rent;
+    free_plots=rh.free_plots;
+    free_plots.remap(plots);
+    total_tacs=rh.total_tacs;
+    fix_tacs=rh.fix_tacs;
+    var_tacs=rh.var_tacs;
+    released_plots=rh.released_plots;
+    plot_index=rh.plot_index;
+    rings=rh.rings;
+    components=rh.components;
+    layout=rh.layout;
+    counted_layout=rh.counted_layout;
 }
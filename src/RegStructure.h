@@ -14,6 +14,13 @@
 #define RegStructureH
 #include "RegGlobals.h"
 #include "RegFarm.h"
+#include "RegPlotInformation.h"
+#include "RegPlot.h"
+#include "RegPlotStore.h"
+#include "RegPlotIndex.h"
+#include "RegFreePlotSet.h"
+#include "RegPlotComponents.h"
+#include "RegPlotRings.h"
 /** RegRegionInfo class.
     The class manages the region, ie. the plots
     @author Kathrin Happe, Alfons Balmann, Konrad Kellermann
@@ -39,6 +46,22 @@ private:
     double total_tacs;
     double var_tacs;
     double fix_tacs;
+    /// number of plots set free so far
+    unsigned long released_plots;
+    /// free plots per soil type for the weighted plot search
+    RegPlotIndex plot_index;
+    /// plots by distance for FAST_PLOT_SEARCH
+    RegPlotRings rings;
+    /// contiguous plots of the farms
+    RegPlotComponents components;
+    /// changes of the dead plots and soil types, contiguous_plots is
+    /// counted again when it differs from counted_layout
+    long layout;
+    long counted_layout;
+    /// data of the plots, plots holds its handles
+    RegPlotStore plot_store;
+    /// plot ids in the order of their slots in plot_store
+    vector<int> plotOrder() const;
 public:
 	int getRandom_contractLength();
 	int getRandom_freePlot_initLand();
@@ -67,13 +90,46 @@ public:
     void setOwnedPlot(RegPlotInfo* p,RegFarmInfo* f);
     void setFarmsteadPlot(RegPlotInfo* p,RegFarmInfo* f);
     void releasePlot(RegPlotInfo* p);
+    /// increases whenever a plot becomes free
+    unsigned long getReleasedPlots() const {
+        return released_plots;
+    }
+    /** true if findMostPreferablePlotOfType() searches the region index:
+        while the farms get their initial land and with INDEXED_PLOT_SEARCH
+        when the costs of a plot are not below its distance costs
+    */
+    bool usePlotIndex() const;
+    /** free plot of type with the lowest costs for farm, of equal costs
+        the first plot of the region; without the index the search of
+        farm_plot is used
+    */
+    RegPlotInformationInfo findMostPreferablePlotOfType(RegPlotInfo* farm_plot, int type, RegFarmInfo* farm);
+    /** FAST_PLOT_SEARCH: nearest free plot of type to the farmstead of
+        farm, the search goes on where the last one of farm stopped
+        @return NULL if there is no free plot of type
+    */
+    RegPlotInfo* findFreePlotOfType(RegFarmInfo* farm, int type);
+    /// as p->identifyPlotsSameStateAndFarm(farm)
+    int identifyPlotsSameStateAndFarm(RegPlotInfo* p, int farm);
+    /// contiguous plot of the farm plot p, the same number for all its plots
+    int getContiguousPlotId(RegPlotInfo* p) {
+        return components.root(plots, p);
+    }
+    /// number of plots of the contiguous plot of the farm plot p
+    int getContiguousPlotSize(RegPlotInfo* p) {
+        return components.size(plots, p);
+    }
+    /// position of plot (row,col) on the Z-order (Morton) curve
+    static uint64_t zOrder(int row, int col);
     void occupyPlot(RegPlotInfo* p, RegFarmInfo* f);
     int cPoT(int i);
-    void initPlotSearch();
+    /// FAST_PLOT_SEARCH: the plot table and the cursors of farms
+    void initPlotSearch(const list<RegFarmInfo*>& farms);
 
 	/// vector of pointer to all plots in the region
     vector<RegPlotInfo* > plots;
-    vector<RegPlotInfo* > free_plots;
+    /// free plots in the order they became free
+    RegFreePlotSet free_plots;
 
     // antonello
     int getNumberOfLandPlotsOfType(int type) {
@@ -0,0 +1,78 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// RegThreadPool.cpp
+//---------------------------------------------------------------------------
+#include "RegThreadPool.h"
+
+RegThreadPool::RegThreadPool(int threads)
+    : job(NULL), job_size(0), next(0), busy(0), generation(0), stop(false) {
+    for (int i=1;i<threads;i++)
+        workers.push_back(thread(&RegThreadPool::work, this));
+}
+
+RegThreadPool::~RegThreadPool() {
+    {
+        lock_guard<mutex> lock(m);
+        stop = true;
+    }
+    start.notify_all();
+    for (unsigned int i=0;i<workers.size();i++)
+        workers[i].join();
+}
+
+void
+RegThreadPool::run(int n, const function<void(int)>& f) {
+    if (workers.empty() || n<2) {
+        for (int i=0;i<n;i++)
+            f(i);
+        return;
+    }
+    {
+        lock_guard<mutex> lock(m);
+        job = &f;
+        job_size = n;
+        next = 0;
+        busy = workers.size();
+        generation++;
+    }
+    start.notify_all();
+    runJob();
+    unique_lock<mutex> lock(m);
+    done.wait(lock, [this] { return busy==0; });
+    job = NULL;
+}
+
+// takes the next index until all are taken
+void
+RegThreadPool::runJob() {
+    for (int i=next++; i<job_size; i=next++)
+        (*job)(i);
+}
+
+void
+RegThreadPool::work() {
+    long seen = 0;
+    for (;;) {
+        {
+            unique_lock<mutex> lock(m);
+            start.wait(lock, [&] { return stop || generation!=seen; });
+            if (stop)
+                return;
+            seen = generation;
+        }
+        runJob();
+        lock_guard<mutex> lock(m);
+        if (--busy==0)
+            done.notify_one();
+    }
+}
@@ -0,0 +1,59 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+//---------------------------------------------------------------------------
+// RegThreadPool.h
+//---------------------------------------------------------------------------
+#ifndef RegThreadPoolH
+#define RegThreadPoolH
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+using namespace std;
+
+/** RegThreadPool class.
+    @short fixed set of worker threads, used to run replications at once
+    (JOBS). run(n,f) calls f(0),...,f(n-1) on the workers and the calling
+    thread and returns when all calls are done.
+*/
+class RegThreadPool {
+public:
+    /// @param threads number of threads including the calling one
+    RegThreadPool(int threads);
+    ~RegThreadPool();
+    int size() const {
+        return workers.size()+1;
+    }
+    void run(int n, const function<void(int)>& f);
+private:
+    vector<thread> workers;
+    mutex m;
+    condition_variable start;
+    condition_variable done;
+    /// job of the current run()
+    const function<void(int)>* job;
+    int job_size;
+    atomic<int> next;
+    /// workers not yet finished with the current job
+    int busy;
+    long generation;
+    bool stop;
+    void work();
+    void runJob();
+};
+
+#endif
@@ -61,8 +61,12 @@
 #define UPPER_MASK 0x80000000UL /* most significant w-r bits */
 #define LOWER_MASK 0x7fffffffUL /* least significant r bits */
 
-static unsigned long x[N];      /* the array for the state vector  */
-static unsigned long *p0, *p1, *pm;
+/* the state lives in RandMT, p0, p1 and pm are indexes into x so that
+   the state can be copied with the simulation */
+RandMT::RandMT()
+  : p0(-1), p1(0), pm(0), n2(0.0), n2_cached(0)
+{
+}
 
 /*
    initialize with a seed
@@ -75,7 +79,7 @@ static unsigned long *p0, *p1, *pm;
    2002-01-09 modified by Makoto Matsumoto
 */
 void
-init_genrand(unsigned long s)
+RandMT::init_genrand(unsigned long s)
 {
   int i;
 
@@ -84,9 +88,9 @@ init_genrand(unsigned long s)
     x[i] = (1812433253UL * (x[i - 1] ^ (x[i - 1] >> 30)) + i)
       & 0xffffffffUL;           /* for >32 bit machines */
   }
-  p0 = x;
-  p1 = x + 1;
-  pm = x + M;
+  p0 = 0;
+  p1 = 1;
+  pm = M;
 }
 
 /*
@@ -99,7 +103,7 @@ init_genrand(unsigned long s)
    2004-02-26 slight change for C++
 */
 void
-init_by_array(unsigned long init_key[], int key_length)
+RandMT::init_by_array(unsigned long init_key[], int key_length)
 {
   int i, j, k;
 
@@ -132,23 +136,23 @@ init_by_array(unsigned long init_key[], int key_length)
 
 /* generates a random number on the interval [0,0xffffffff] */
 unsigned long
-genrand_int32(void)
+RandMT::genrand_int32(void)
 {
   unsigned long y;
 
-  if (!p0) {
+  if (p0 < 0) {
     /* Default seed */
     init_genrand(5489UL);
   }
   /* Twisted feedback */
-  y = *p0 = *pm++ ^ (((*p0 & UPPER_MASK) | (*p1 & LOWER_MASK)) >> 1)
-    ^ (-(*p1 & 1) & MATRIX_A);
+  y = x[p0] = x[pm++] ^ (((x[p0] & UPPER_MASK) | (x[p1] & LOWER_MASK)) >> 1)
+    ^ (-(x[p1] & 1) & MATRIX_A);
   p0 = p1++;
-  if (pm == x + N) {
-    pm = x;
+  if (pm == N) {
+    pm = 0;
   }
-  if (p1 == x + N) {
-    p1 = x;
+  if (p1 == N) {
+    p1 = 0;
   }
   /* Temper */
   y ^= y >> 11;
@@ -160,14 +164,14 @@ genrand_int32(void)
 
 /* generates a random number on the interval [0,0x7fffffff] */
 long
-genrand_int31(void)
+RandMT::genrand_int31(void)
 {
   return (long) (genrand_int32() >> 1);
 }
 
 /* generates a random number on the real interval [0,1] */
 double
-genrand_real1(void)
+RandMT::genrand_real1(void)
 {
   return genrand_int32() * (1.0 / 4294967295.0);
   /* divided by 2^32-1 */
@@ -175,7 +179,7 @@ genrand_real1(void)
 
 /* generates a random number on the real interval [0,1) */
 double
-genrand_real2(void)
+RandMT::genrand_real2(void)
 {
   return genrand_int32() * (1.0 / 4294967296.0);
   /* divided by 2^32 */
@@ -183,7 +187,7 @@ genrand_real2(void)
 
 /* generates a random number on the real interval (0,1) */
 double
-genrand_real3(void)
+RandMT::genrand_real3(void)
 {
   return (((double) genrand_int32()) + 0.5) * (1.0 / 4294967296.0);
   /* divided by 2^32 */
@@ -191,21 +195,19 @@ genrand_real3(void)
 
 /* generates a 53-bit random number on the real interval [0,1) */
 double
-genrand_res53(void)
+RandMT::genrand_res53(void)
 {
   unsigned long a = genrand_int32() >> 5, b = genrand_int32() >> 6;
 
   return (a * 67108864.0 + b) * (1.0 / 9007199254740992.0);
 }
 
-void randInit(unsigned long int x ){init_genrand(x);}
-long int randlong(void){ return genrand_int31();}
+void RandMT::randInit(unsigned long int s) {init_genrand(s);}
+long int RandMT::randlong(void){ return genrand_int31();}
 
 //============Polar methode ============================================
 
-double rand_normal(double mean, double stddev) {
-    static double n2 = 0.0;
-    static int n2_cached = 0;
+double RandMT::rand_normal(double mean, double stddev) {
     if (!n2_cached) {
         double x, y, r;
 	do {
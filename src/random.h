@@ -13,12 +13,35 @@
 #ifndef MT_RANDH
 #define MT_RANDH
 
-void randInit(unsigned long int x );
+const long int mtRandMin = 0 ;
+const long int mtRandMax = 0x7FFFFFFFUL ;
 
-long int randlong(void);
+/** RandMT class.
+    @short Mersenne Twister (MT19937) of one simulation.
+    The state is a value, simulations running side by side in one
+    process each draw from their own generator.
+*/
+class RandMT {
+public:
+    RandMT();
+    void randInit(unsigned long int x );
+    long int randlong(void);
+    double rand_normal(double mean, double stddev);
+private:
+    void init_genrand(unsigned long s);
+    void init_by_array(unsigned long init_key[], int key_length);
+    unsigned long genrand_int32(void);
+    long genrand_int31(void);
+    double genrand_real1(void);
+    double genrand_real2(void);
+    double genrand_real3(void);
+    double genrand_res53(void);
 
-extern long int mtRandMin ;
-extern long int mtRandMax ;
-
-double rand_normal(double mean, double stddev);
+    /// the array for the state vector
+    unsigned long x[624];
+    int p0, p1, pm;
+    /// second number of the polar method
+    double n2;
+    int n2_cached;
+};
 #endif
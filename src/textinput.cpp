@@ -17,12 +17,15 @@
 #include <stdio.h>
 #include <iterator>
 #include <vector>
+#include <set>
+#include <regex>
 #include "textinput.h"
 #include "RegGlobals.h"
 
-string inputdir;
-bool hasCarbon;
-extern RegGlobalsInfo* gg;
+RegInputData::RegInputData()
+    : hasCarbon(false) {
+}
+
 static void tokenize(const string& str,
                       vector<string>& tokens,
                       const string& delimiters = ": \t=;\r")
@@ -57,8 +60,7 @@ static string trim(const std::string& str, const std::string& whitespace = " \t\
 }
 
 
-//static
- void glob(string fname=GLOBFILE) {
+void RegInputData::glob(RegGlobalsInfo* g, string fname) {
     ifstream ins;
     stringstream gfile;
 	gfile << inputdir << fname;  // GLOBFILE;
@@ -90,29 +92,28 @@ static string trim(const std::string& str, const std::string& whitespace = " \t\
                 globdata.namesOfSoilTypes.push_back(tokens[k]);
            }
         }else {
-		//	if (gg->Scenario_globs.count(tokens[0]))
-		//		globdata.globs.insert(pair<string, string>(tokens[0], gg->Scenario_globs[tokens[0]]));
+		//	if (g->Scenario_globs.count(tokens[0]))
+		//		globdata.globs.insert(pair<string, string>(tokens[0], g->Scenario_globs[tokens[0]]));
         //   else 
 			globdata.globs.insert(pair<string, string>(tokens[0], tokens[1]));
 		}
     }
     ins.close();
-	for (auto x : gg->Scenario_globs) {
+	for (auto x : g->Scenario_globs) {
 		globdata.globs[x.first] = x.second;
 	}
     return;
 }
 
-void demograph() {
-	 glob(DEMOGRAPH_FILE);
+void RegInputData::demograph(RegGlobalsInfo* g) {
+	 glob(g, DEMOGRAPH_FILE);
  }
 
-void youngfarmer() {
-	glob(YOUNGFARMER_FILE);
+void RegInputData::youngfarmer(RegGlobalsInfo* g) {
+	glob(g, YOUNGFARMER_FILE);
 }
 
-//static
- void trans() {
+void RegInputData::trans() {
     ifstream ins;
     stringstream ifile;
     ifile<< inputdir <<TRANSLFILE;
@@ -151,8 +152,7 @@ void youngfarmer() {
     return;
 }
 
-//static
-void farms() {
+void RegInputData::farms() {
     ifstream ins;
     stringstream ifile;
     ifile<< inputdir <<FARMSDATAFILE;
@@ -328,9 +328,8 @@ void farms() {
     return;
 }
 
-static map <string, int> initInvestCols;
-//static
-void nfarms() {
+void RegInputData::nfarms() {
+    map <string, int> initInvestCols;
     int noft = farmsdata.names.size();
     string name, namefile;
  for (int i = 0; i< noft; i++) {
@@ -407,8 +406,7 @@ void nfarms() {
   return;
 }
 
-//static
-void readenv() {
+void RegInputData::readenv() {
     int zust=0;
     ifstream ins;
     stringstream ifile;
@@ -529,28 +527,27 @@ void readenv() {
     return;
 }
 
-static map <string, int> marketCols;
-//static
-void readmarket() {
+void RegInputData::readmarket(RegGlobalsInfo* g) {
+    map <string, int> marketCols;
 	vector<string> names{ "ST_BORROW_CAP","EC_INTEREST" ,"V_HIRED_LABOUR", "V_OFF_FARM_LAB"};
 	for (auto &nam : names) {
 		oneproduct prod;
 		int ind;
 		float lab;
 		if (nam == "ST_BORROW_CAP") {
-			ind = gg->ST_BOR_INTERESTTYPE;
+			ind = g->ST_BOR_INTERESTTYPE;
 			lab = 0;
 		}
 		else if (nam == "EC_INTEREST") {
-			ind = gg->ST_EC_INTERESTTYPE;
+			ind = g->ST_EC_INTERESTTYPE;
 			lab = 0;
 		}
 		else if (nam == "V_HIRED_LABOUR") {
-			ind = gg->VARHIREDLABTYPE;
+			ind = g->VARHIREDLABTYPE;
 			lab = -1;
 		}
 		else if (nam == "V_OFF_FARM_LAB") {
-			ind = gg->VAROFFARMLABTYPE;
+			ind = g->VAROFFARMLABTYPE;
 			lab = 1;
 		}
 		if (globdata.globs[nam] != "") {
@@ -659,9 +656,8 @@ void readmarket() {
   return;
 }
 
-static map <string, int> envCols;
-//static
-void readenvmarket() {
+void RegInputData::readenvmarket() {
+    map <string, int> envCols;
     ifstream ins;
 
     stringstream ifile;
@@ -738,9 +734,8 @@ void readenvmarket() {
   return;
 }
 
-static map <string, int> yieldCols;
-//static
-void readyield() {
+void RegInputData::readyield() {
+    map <string, int> yieldCols;
     ifstream ins;
 
     stringstream ifile;
@@ -830,9 +825,8 @@ void readyield() {
   return;
 }
 
-static map <string, int> investCols;
-//static
-void readinvest() {
+void RegInputData::readinvest(RegGlobalsInfo* g) {
+    map <string, int> investCols;
 	investdata.FixOffFarmLabName = "OFFFARMLAB";
 	investdata.FixHiredLabName = "HIREDLAB";
 
@@ -948,11 +942,11 @@ void readinvest() {
   double ls;
   for (auto &nm : names) {
 	  if (nm == "HIREDLAB") {
-		  ind = gg->HIREDLABTYPE;
+		  ind = g->HIREDLABTYPE;
 		  ls = labsub;
 	  }
 	  else if (nm == "OFFFARMLAB") {
-		  ind = gg->OFFFARMLABTYPE;
+		  ind = g->OFFFARMLABTYPE;
 		  ls = -labsub;
 	  }
 	  oneinvest inv = oneinvest(ind, nm, stof(globdata.globs[nm]), ls);
@@ -961,8 +955,7 @@ void readinvest() {
   return;
 }
 
-//static
-void  readmatrix() {
+void RegInputData::readmatrix() {
     ifstream ins;
     stringstream ss;
     int zust=0;
@@ -1044,8 +1037,7 @@ void  readmatrix() {
    return;
 }
 
-//static
-void  readmatrix_new() {
+void RegInputData::readmatrix_new() {
     ifstream ins;
     stringstream ss;
     int zust=0;
@@ -1161,8 +1153,7 @@ void  readmatrix_new() {
    return;
 }
 
-//static
-void  readcaplinks() {
+void RegInputData::readcaplinks() {
     ifstream ins;
     stringstream ss;
     int i=0;
@@ -1199,8 +1190,7 @@ void  readcaplinks() {
 	return;
 }
 
-//static
-void  readobjlinks() {
+void RegInputData::readobjlinks() {
     ifstream ins;
     stringstream ss;
     int i=0;
@@ -1236,8 +1226,7 @@ void  readobjlinks() {
     return;
 }
 
-//static
-void  readmatrixlinks() {
+void RegInputData::readmatrixlinks() {
     ifstream ins;
     stringstream ss;
     int i=0;
@@ -1302,8 +1291,7 @@ void  readmatrixlinks() {
   return;
 }
 
-//static
-void readmip(){
+void RegInputData::readmip() {
     //readmatrix();
     readmatrix_new();
     readcaplinks();
@@ -1312,31 +1300,402 @@ void readmip(){
  return ;
 }
 
-void readfiles(string idir, bool hasSoilservice){
-    inputdir = idir;
-	hasCarbon = hasSoilservice;
+static double getFactor(string str){
+    string tstr = trim(str," ()");
+    double d = stod(tstr); 
+    
+    return d;
+}
+
+static vector<double> getFactorList(string str) {
+    vector<double> vec;
+	string tstr = trim(str, " {}");
+	regex sep("[, ()]+");
+	auto it = sregex_token_iterator(tstr.begin(),tstr.end(), sep,-1);
+	sregex_token_iterator tend;
+    for(;it!=tend;++it) {
+		string astr = (*it);
+		if (astr.length()==0) continue;
+		vec.push_back(getFactor(astr));
+	}
+    return vec;
+}
+
+static vector<string> getVarNames(const RegInputData& in, map<string,int> m, string str){
+    const struct matrixdata& matrixdata = in.matrixdata;
+  vector<string> avec;
+  string str1, str2;
+  smatch sm;
+  if (!regex_search(str,sm,regex("=>"))) {
+	  cout << "=> not found in the name range.\n";
+	  exit(5);
+  }
+  str1 = trim(sm.prefix(),"{ ");
+  str2 = trim (sm.suffix(), "} ");
+      
+  if (m.find(str1)!=m.end() && m.find(str2)!=m.end()) {
+       for (int i=m[str1]; i<=m[str2]; ++i) {
+			avec.push_back(matrixdata.colnames[i]);
+	    }
+  }
+  return move(avec);
+}
+
+static pair<string,double> getTerm(const RegInputData& in, string str, string name){
+    const struct investdata& investdata = in.investdata;
+    const struct marketdata& marketdata = in.marketdata;
+    auto pos1 = str.find_first_of('.', 0); 
+    string fname = str.substr(0,pos1);
+    string cname = str.substr(pos1+1, str.size()-1-pos1);
+    double val;
+    if (!fname.compare("market")) {
+		auto prod = marketdata.products;
+        auto ap = prod[0];
+        for (auto &p: prod) {
+            if (!name.compare(p.name)) {
+                ap = p;
+                break;
+			}
+		}
+        if (!cname.compare("labour")) {
+			val = ap.labour;
+		}else if (!cname.compare("initPrem")) {
+			val = ap.initprem;
+		}else {
+            cout << "not implemented yet.\n";
+            exit(5);
+		}
+	}else if (!fname.compare("investments")) {
+		auto inv = investdata.invests;
+        auto ai = inv[0];
+		for (auto &v:inv){
+			if (!name.compare(v.name)) {
+                ai = v;
+                break;
+	    	}
+		}
+        if (!cname.compare("labSub")){
+            val = ai.labsub;
+		}else if (!cname.compare("capacity")){
+			val = ai.capacity;
+		}else {
+            cout << "not yet implemented. \n";
+            exit(5);
+		}
+	}
+	else {
+		cout << "not implemented yet. \n";
+        exit(5);
+	}
+    return make_pair(name,val);
+}
+
+static vector<pair<string,double>> getTerms(const RegInputData& in, string text, string namerange=""){
+    const struct investdata& investdata = in.investdata;
+    const struct marketdata& marketdata = in.marketdata;
+    vector<pair<string,double>> terms;
+    
+    auto pos1 = text.find_first_of('.', 0); 
+    auto pos2 = text.find_first_of('.', pos1+1);
+    string fname = text.substr(0,pos1);
+    string cname = text.substr(pos1+1, pos2-pos1-1);
+
+	bool totake = false;
+    bool tocheck = false;
+
+	if (namerange.length()==0) {
+		totake = true;
+	}
+
+	string nam1, nam2;
+	smatch sm;
+	if (!totake){
+	  tocheck = true;
+	  if (regex_search(namerange, sm, regex("=>"))) {
+		nam1 = trim(sm.prefix(),"{ ");
+		nam2 = trim(sm.suffix(), "} ");
+	  }else {
+		cout << "not a valid range of variables. \n";
+		exit (5);
+	  }
+	}
+
+	bool over = false;
+    string astr;
+    double aval;
+    if (!fname.compare("market")) {
+        //norange
+        for (auto &x: marketdata.products) {
+			if (over) break;
+			if (!totake) {
+				if ((x.name).compare(nam1)) continue;
+				else totake  = true;
+			}
+			if (totake) {
+              astr = x.name;
+              if (!cname.compare("labour")) {
+                  aval = x.labour;
+			  }else if (!cname.compare("initPrem")){
+				  aval = x.initprem;
+			  }else {
+                  cout << "not implemented yet. \n";
+                  exit(5);
+			  }
+			  if (tocheck) {
+		      if (!((x.name).compare(nam2))) 
+				  over = true;
+			  }
+			}
+			terms.push_back(make_pair(astr,aval));
+		}
+	}else if(!fname.compare("investments")) {
+        
+		for (auto &x: investdata.invests){
+			if(over) break;
+			if (!totake) {
+				if (!((x.name).compare(nam1))) {
+					totake = true;
+				}
+			}
+			if (totake) {
+              astr = x.name;
+              if (!cname.compare("labSub")){
+				 aval = x.labsub;
+			  }else if (!cname.compare("capacity")){
+                  aval = x.capacity;
+			  }else {
+                  cout << "not yet implemented.\n";
+                  exit(5);
+			  }
+			  if (tocheck) {
+			    if (!((x.name).compare(nam2))) {
+				  over = true;
+			    }
+			  }
+			  terms.push_back(make_pair(astr,aval));
+			}
+		}
+	}else {
+        cout << " I dont know where to find the data from " << fname << endl;
+        exit(5);
+	}
+
+    return move(terms);
+}
+
+// the MIP matrix of the terms of matrix_new.txt
+void RegInputData::mkmatrix() {
+    int ind=0;
+    map<string,int> colInd;
+	for (auto &x:matrixdata_n.VarNames0) {
+        if (!trim(x, " ").compare("market.name._all_")) {
+			for( auto ap: marketdata.products){
+				matrixdata.colnames.push_back(ap.name);
+                colInd[ap.name]=ind++;
+			}
+		}else if(!trim(x, " ").compare("investments.name._all_")) {
+			for (auto ai: investdata.invests){
+				matrixdata.colnames.push_back(ai.name);
+                colInd[ai.name]=ind++;
+			}
+		}else {
+			matrixdata.colnames.push_back(trim(x, " "));
+            colInd[trim(x, " ")]=ind++;
+		}
+	}
 
-    glob();
-	if (gg->ManagerDemographics)
-		demograph();
+    set<string> intSet;
+	for (auto &ii: matrixdata_n.IntVars0) {
+        if (ii.find("=>")!=std::string::npos) {
+            smatch sm;
+            regex_search(ii, sm, regex("=>"));
+			string nam1=trim(sm.prefix(),"{ ");
+			string nam2=trim(sm.suffix(),"} ");
+            if (colInd.find(nam1)!=colInd.end() && colInd.find(nam2)!=colInd.end()) {
+                for (int i=colInd[nam1]; i<=colInd[nam2]; ++i) {
+                    intSet.insert(matrixdata.colnames[i]);
+				}
+			}else {
+                 cout << nam1 << " or " << nam2 << "not found as a variable name\n";
+                 exit(5);
+			}
+		}else {
+            intSet.insert(trim(ii, " "));
+		}
+	}
+    for (auto &x: matrixdata.colnames) {
+        if ( intSet.find(x)!=intSet.end()) {
+			matrixdata.isInt.push_back(1);
+		}
+		else
+			matrixdata.isInt.push_back(0);
+	}
 
-	if (gg->YoungFarmer)
-		youngfarmer();
+    //rownames and mat
+    //int ri = 0;
+	for (auto &x: matrixdata_n.Restricts0) {
+		string xname=trim(x.name, " ");
+		if (xname.length() == 0) {
+			cout << "Error : no restriction name ?\n";
+			exit(5);
+		}
+		string uname;
+		uname.resize(xname.size());
+		transform(xname.begin(), xname.end(),uname.begin(), (int (*)(int))std::toupper);
+		matrixdata.rownames.push_back(uname);
+        
+        vector<double> avec;
+		avec.resize(colInd.size(),0);
+		smatch sm;
+		string str1,str2,str3;
+		vector<string> nams;
+		vector<double> vals;
+		vector<pair<string,double>> terms;
+		for (auto &x2: x.terms0) {
+			if ((trim(x2, " ").length()==0)) continue;
+            if (x2.find("matrixLinks")!=string::npos) continue;
+            if (x2.find("_defaultLinks_")!=string::npos) continue;
+            
+			double val;
+            vector<pair<string,double>> tms;
+            vector<string> ns;
+			regex stern("\\*");
+		    int cnt = std::distance(std::sregex_iterator(x2.begin(),x2.end(),stern),std::sregex_iterator());
+	        switch (cnt) {
+			case 0:
+				if (x2.find(".")!=string::npos ){
+                    tms = getTerms(*this, x2);
+                    for (auto tt: tms){
+						//matrixdata.mat[ri][colInd[tt.first]] = tt.second;
+						avec[colInd[tt.first]] = tt.second;
+					}
+		        }else if (x2.find("=>")!=string::npos) {
+                    ns = getVarNames(*this, colInd, x2);
+                    for (auto tt: ns){
+                        avec[colInd[tt]] = 1;
+						//matrixdata.mat[ri][colInd[tt]] = 1;
+					}
+				}else {
+					avec[colInd[x2]] = 1;
+					//matrixdata.mat[ri][colInd[x2]] = 1;
+				}
+                break;
+			case 1:
+				regex_search(x2,sm,regex("\\*"));
+				str1=trim(sm.prefix(), " ");
+				str2=trim(sm.suffix(), " ");
+				
+				if (str1.find("market.")!=string::npos || str1.find("investments.")!=string::npos) {
+					if (str2.find("=>")!=string::npos) {
+						terms = getTerms(*this, str1,str2);
+						for (auto tt:terms){
+							avec[colInd[tt.first]] = tt.second;
+							//matrixdata.mat[ri][colInd[tt.first]]=tt.second;
+						}
+					}else {
+						avec[colInd[str2]] = (getTerm(*this, str1,str2)).second;
+						//matrixdata.mat[ri][colInd[str2]] = (getTerm(str1,str2)).second;
+					}
+				}else if (str1.find("{")!=string::npos) {
+					vals = getFactorList(str1);
+					nams = getVarNames(*this, colInd,str2);
+					int sz = vals.size();
+					for (int i=0;i<sz;++i){
+						avec[colInd[nams[i]]] = vals[i];
+						//matrixdata.mat[ri][colInd[nams[i]]] = vals[i];
+					}
+				}else {
+					val = getFactor(str1);
+					if (str2.find("=>")!=string::npos) {
+						nams = getVarNames(*this, colInd, str2);
+						for (auto nn:nams){
+							avec[colInd[nn]] = val;
+							//matrixdata.mat[ri][colInd[nn]]=val;
+						}
+					}else if (str2.find(".")!=string::npos) {
+						terms = getTerms(*this, str2);
+						for (auto &tt:terms){
+							avec[colInd[tt.first]] = val*tt.second;
+							//matrixdata.mat[ri][colInd[tt.first]] = val*tt.second;
+						}
+					}else {  //one Variable
+						avec[colInd[str2]] = val;
+						//matrixdata.mat[ri][colInd[str2]] = val;
+					}
+				}
+                break;
+			case 2:
+				regex_search(x2,sm,regex("(.*)\\*(.*)\\*(.*)"));
+				str1=trim(sm[1], " ");
+				str2=trim(sm[2], " ");
+				str3=trim(sm[3], " ");
+				
+				val = getFactor(str1);
+				if (str2.find("{")!=string::npos) {
+					vals = getFactorList(str2);
+					nams = getVarNames(*this, colInd,str3);
+					int sz = vals.size();
+					for (int i=0;i<sz;++i){
+						avec[colInd[nams[i]]] = val*vals[i];
+						//matrixdata.mat[ri][colInd[nams[i]]] = val * vals[i];
+					}
+				}else if (str3.find("{")!=string::npos){
+					terms = getTerms(*this, str2,str3);
+					for (auto &tt:terms){
+						avec[colInd[tt.first]] = val*tt.second;
+						//matrixdata.mat[ri][colInd[tt.first]] = val*tt.second;
+					}
+				}else { //one varialble name
+					avec[colInd[str3]] = val*(getTerm(*this, str2,str3)).second;
+					//matrixdata.mat[ri][colInd[str3]] = val*(getTerm(str2,str3)).second;
+				}
+				break;
+			default: ;
+			}
+		}
+		matrixdata.mat.push_back(avec);
+		//++ri;
+	}
+}
+
+void RegInputData::readfiles(RegGlobalsInfo* g) {
+    inputdir = g->INPUTFILEdir;
+	hasCarbon = g->HAS_SOILSERVICE;
+
+    glob(g);
+	if (g->ManagerDemographics)
+		demograph(g);
+
+	if (g->YoungFarmer)
+		youngfarmer(g);
 
     farms();
     nfarms();
 
-	if (gg->ENV_MODELING)
+	if (g->ENV_MODELING)
 		readenv();
 
-    readmarket();
+    readmarket(g);
 
-	if (gg->ENV_MODELING)
+	if (g->ENV_MODELING)
         readenvmarket();
 
 	if (hasCarbon) readyield();
-    readinvest();
+    readinvest(g);
 
     readmip();
+    mkmatrix();
+    mkIDs();
     return;
 }
+
+void RegInputData::mkIDs() {
+    for (unsigned int i = 0; i < matrixdata.rownames.size(); i++)
+        rowindex[matrixdata.rownames[i]] = i;
+    for (unsigned int i = 0; i < matrixdata.colnames.size(); i++)
+        colindex[matrixdata.colnames[i]] = i;
+    for (unsigned int i = 0; i < marketdata.products.size(); i++)
+        marketId[marketdata.products[i].name] = i;
+    for (unsigned int i = 0; i < investdata.invests.size(); i++)
+        investId[investdata.invests[i].name] = i;
+}
@@ -51,7 +51,6 @@ const string  MATLFILE  =  "matrixLinks.txt";
 const string YIELDFILE = "yield.txt";
 
 
-extern string   inputdir;
 
 struct lands
 {
@@ -80,7 +79,6 @@ struct farmsdata {
    vector <double> rel_invest_ages;
 };
 
-extern struct farmsdata farmsdata  ;
 
 struct oneInvest {
     string   name;
@@ -95,20 +93,22 @@ struct farminvestdata {
     vector < oneInvest >  initinvests;
 };
 
-extern map <string  , farminvestdata > farmsIinvest;
 
 struct globdata {
    vector <string  > namesOfSoilTypes;
    map <string  , string  > globs;
+   /// value of name, empty if it is not given
+   string get(const string& name) const {
+       map<string, string>::const_iterator it = globs.find(name);
+       return it!=globs.end() ? it->second : string();
+   }
 } ;
 
-extern struct globdata globdata;
 
 struct transdata {
     map <string   , string  > trans;
 };
 
-extern struct transdata transdata  ;
 
 struct matrixdata {
     vector <string  > rownames;
@@ -117,7 +117,6 @@ struct matrixdata {
     vector <vector<double> > mat;
 } ;
 
-extern struct matrixdata matrixdata  ;
 
 struct aRestrict0 {
     string name;
@@ -130,7 +129,6 @@ struct matrixdata_n {
     vector <aRestrict0> Restricts0;
 } ;
 
-extern struct matrixdata_n matrixdata_n  ;
 
 struct aRestrict {
     string name;
@@ -158,13 +156,11 @@ struct caplinkdata{
      vector <onelink> caplinks;
 } ;
 
-extern struct caplinkdata caplinkdata   ;
 
 struct objlinkdata {
      vector<onelink> objlinks;
 } ;
 
-extern struct objlinkdata objlinkdata   ;
 
 struct onematlink {
     string   row;
@@ -181,7 +177,6 @@ struct matlinkdata {
      vector <onematlink> matlinks;
 };
 
-extern struct matlinkdata   matlinkdata   ;
 
 struct envproduct {
     string   name;
@@ -200,7 +195,6 @@ struct envmarketdata {
      vector <envproduct> envproducts;
 } ;
 
-extern struct envmarketdata  envmarketdata    ;
 
 
 struct oneinvest {
@@ -225,7 +219,6 @@ struct investdata {
       vector <oneinvest>  invests;
 }  ;
 
-extern struct investdata investdata     ;
 
 struct oneproduct {
     int type;
@@ -260,14 +253,12 @@ struct oneyield {
 	double p, k, pesticide, energyvar;
 };
 
-extern vector <oneyield> yielddata;
 
 struct marketdata {
     string   premiumName;
     vector <oneproduct> products;
 }  ;
 
-extern struct marketdata marketdata    ;
 
 struct act {
     string   name;
@@ -292,11 +283,68 @@ struct envdata {
       vector <group> groups;
 } ;
 
-extern struct envdata  envdata ;
 
 extern const string  colsmarket[];
 extern const string  colsinvest[];
 extern const string  transwords[];
 
-void readfiles(string,bool  );
+class RegGlobalsInfo;
+
+/** RegInputData struct.
+    @short the input files of one simulation as read by readfiles().
+    Replications of one process share the data they read; readfiles()
+    also builds the indexes of the names, so the data is not changed
+    afterwards.
+*/
+struct RegInputData {
+    string inputdir;
+    bool hasCarbon;
+
+    struct farmsdata farmsdata;
+    map <string, farminvestdata> farmsIinvest;
+    struct globdata globdata;
+    struct transdata transdata;
+    struct matrixdata matrixdata;
+    struct matrixdata_n matrixdata_n;
+    struct caplinkdata caplinkdata;
+    struct objlinkdata objlinkdata;
+    struct matlinkdata matlinkdata;
+    struct envmarketdata envmarketdata;
+    struct investdata investdata;
+    vector <oneyield> yielddata;
+    struct marketdata marketdata;
+    struct envdata envdata;
+
+    /// indexes of the rows and columns of the MIP matrix and of the
+    /// products and investments by name
+    map <string, int> colindex;
+    map <string, int> rowindex;
+    map <string, int> marketId;
+    map <string, int> investId;
+
+    RegInputData();
+    /// reads the input files of g->INPUTFILEdir
+    void readfiles(RegGlobalsInfo* g);
+
+private:
+    void glob(RegGlobalsInfo* g, string fname=GLOBFILE);
+    void demograph(RegGlobalsInfo* g);
+    void youngfarmer(RegGlobalsInfo* g);
+    void trans();
+    void farms();
+    void nfarms();
+    void readenv();
+    void readmarket(RegGlobalsInfo* g);
+    void readenvmarket();
+    void readyield();
+    void readinvest(RegGlobalsInfo* g);
+    void readmatrix();
+    void readmatrix_new();
+    void readcaplinks();
+    void readobjlinks();
+    void readmatrixlinks();
+    void readmip();
+    void mkmatrix();
+    void mkIDs();
+};
 #endif
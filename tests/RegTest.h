@@ -0,0 +1,48 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+//---------------------------------------------------------------------------
+// RegTest.h
+//---------------------------------------------------------------------------
+#ifndef RegTestH
+#define RegTestH
+
+#include <iostream>
+#include "RegPlot.h"
+
+/// number of failed checks of the test program
+static int test_failures = 0;
+
+/// reports a failed condition and goes on with the test
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << __FILE__ << ":" << __LINE__ << ": " << #cond << " failed" << std::endl; \
+            test_failures++; \
+        } \
+    } while (0)
+
+/// exit code of the test program, 0 if all checks passed
+#define TEST_RESULT() (test_failures==0 ? 0 : 1)
+
+/** idle plots of soil type 0 in store, the slots in the order of the ids,
+    for the tests of the structures of a region
+    @param rows rows of the region, n plots in all
+*/
+static void testPlots(RegPlotStore& store, int rows, int n, vector<RegPlotInfo*>& plots) {
+    vector<int> order(n);
+    for (int i=0;i<n;i++)
+        order[i] = i;
+    store.init(NULL, rows, order, plots);
+}
+
+#endif
@@ -0,0 +1,71 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+//---------------------------------------------------------------------------
+// RegTestSimulation.h
+// a simulation of the input files for the tests, include it once per program
+//---------------------------------------------------------------------------
+#ifndef RegTestSimulationH
+#define RegTestSimulationH
+
+#include "RegManager.h"
+#include "AgriPoliS.h"
+
+/** RegTestManager class.
+    @short simulation whose region and farms the tests may look at
+*/
+class RegTestManager : public RegManagerInfo {
+public:
+    RegTestManager(RegGlobalsInfo* G) : RegManagerInfo(G) {}
+    RegRegionInfo* getRegion() {
+        return Region;
+    }
+    list<RegFarmInfo*>& getFarms() {
+        return FarmList;
+    }
+};
+
+/** globals as main() sets them for the options and scenario of dir
+    @param out output directory of the simulation
+    @param teiler divisor of the numbers of farms (option --TEILER), a
+    large one gives a small region
+*/
+RegGlobalsInfo* testGlobals(const string& dir, const string& out, int teiler) {
+    RegGlobalsInfo* g = new RegGlobalsInfo();
+    g->OPTIONFILEdir = dir + "/";
+    g->SCENARIOFILE = "scenario.txt";
+    readScenario(g);
+    g->V = 0;
+    g->INIT_OUTPUT = true;
+    g->SEED = 0;
+    options(g);
+    g->options.push_back(make_pair(&RegGlobalsInfo::TEILER, teiler));
+    g->OUTPUTFILE = out + "/";
+    return g;
+}
+
+/** checks that every plot has the same state, renter and rent in both
+    simulations
+*/
+void compareLand(RegTestManager& a, RegTestManager& b) {
+    vector<RegPlotInfo*>& plots = a.getRegion()->plots;
+    vector<RegPlotInfo*>& other = b.getRegion()->plots;
+    CHECK(plots.size()==other.size());
+    CHECK(a.getFarms().size()==b.getFarms().size());
+    for (unsigned int i=0;i<plots.size() && i<other.size();i++) {
+        CHECK(plots[i]->getState()==other[i]->getState());
+        CHECK(plots[i]->getRentedByAgent()==other[i]->getRentedByAgent());
+        CHECK(plots[i]->getRentPaid()==other[i]->getRentPaid());
+    }
+}
+
+#endif
@@ -0,0 +1,98 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// testRegBidQueue.cpp
+// RegBidQueue against the offers of all farms compared as rentOnePlot() did
+//---------------------------------------------------------------------------
+#include <random>
+#include <set>
+#include <map>
+#include "RegTest.h"
+#include "RegBidQueue.h"
+
+static const int nfarms = 30;
+static const int types = 2;
+
+int main() {
+    RegPlotStore store;
+    vector<RegPlotInfo*> plots;
+    testPlots(store, 8, 40, plots);
+
+    RegBidQueue queue;
+    queue.init(vector<RegFarmInfo*>(nfarms, (RegFarmInfo*)NULL), types);
+    // current offers and wanted plots of the farms
+    vector<vector<double> > offer(types, vector<double>(nfarms, 0));
+    vector<vector<RegPlotInfo*> > wanted(types, vector<RegPlotInfo*>(nfarms, (RegPlotInfo*)NULL));
+    // farms which have to be asked again, and farms which may be asked
+    // because they wanted a rented plot at some time
+    vector<set<int> > must(types);
+    vector<set<int> > may(types);
+    vector<map<RegPlotInfo*, set<int> > > ever_wanted(types);
+    for (int t=0;t<types;t++)
+        for (int i=0;i<nfarms;i++)
+            must[t].insert(i);
+
+    mt19937 rng(99);
+    for (int round=0;round<3000;round++) {
+        int t = rng()%types;
+        vector<int> changed = queue.changed(t);
+        set<int> asked(changed.begin(), changed.end());
+        CHECK(asked.size()==changed.size());
+        for (set<int>::iterator it=must[t].begin();it!=must[t].end();it++)
+            CHECK(asked.count(*it)==1);
+        for (set<int>::iterator it=asked.begin();it!=asked.end();it++)
+            CHECK(must[t].count(*it)==1 || may[t].count(*it)==1);
+        must[t].clear();
+        may[t].clear();
+
+        // the asked farms bid anew, from few values so that offers are equal
+        for (unsigned int k=0;k<changed.size();k++) {
+            int i = changed[k];
+            offer[t][i] = (double)((int)(rng()%7)-2);
+            wanted[t][i] = rng()%5==0 ? NULL : plots[rng()%plots.size()];
+            queue.setOffer(i, t, offer[t][i], wanted[t][i]);
+            if (wanted[t][i])
+                ever_wanted[t][wanted[t][i]].insert(i);
+        }
+
+        // highest positive offer, of equal offers the first farm
+        int best = -1;
+        for (int i=0;i<nfarms;i++)
+            if (offer[t][i]>0 && (best==-1 || offer[t][i]>offer[t][best]))
+                best = i;
+        double top_offer;
+        int top = queue.top(t, top_offer);
+        CHECK(top==best);
+        CHECK(top_offer==(best==-1 ? 0 : offer[t][best]));
+
+        // the best farm rents its wanted plot
+        if (best!=-1 && wanted[t][best]!=NULL && rng()%3!=0) {
+            RegPlotInfo* p = wanted[t][best];
+            queue.invalidateFarm(best);
+            queue.plotRented(p, t);
+            for (int u=0;u<types;u++)
+                must[u].insert(best);
+            for (int i=0;i<nfarms;i++)
+                if (wanted[t][i]==p)
+                    must[t].insert(i);
+            may[t].insert(ever_wanted[t][p].begin(), ever_wanted[t][p].end());
+            ever_wanted[t].erase(p);
+        }
+        // a farm whose offer changed otherwise
+        if (rng()%4==0) {
+            int i = rng()%nfarms;
+            queue.invalidateOffer(i, t);
+            must[t].insert(i);
+        }
+    }
+    return TEST_RESULT();
+}
@@ -0,0 +1,72 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// testRegFastPlotSearch.cpp
+// in a simulation with FAST_PLOT_SEARCH the free plot a farm finds by
+// RegPlotRings is a nearest free plot of the type
+//---------------------------------------------------------------------------
+#include "RegTest.h"
+#include "RegTestSimulation.h"
+
+/// distance of the nearest free plot of type to the farmstead, -1 if none
+static double nearest(RegRegionInfo* region, RegPlotInfo* farmstead, int type) {
+    double best = -1;
+    for (unsigned int i=0;i<region->plots.size();i++) {
+        RegPlotInfo* p = region->plots[i];
+        if (p->getState()!=0 || p->getSoilType()!=type)
+            continue;
+        double d = farmstead->calculateDistance(p);
+        if (best<0 || d<best)
+            best = d;
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cout << "usage: testRegFastPlotSearch <input directory> <output directory>" << endl;
+        return 2;
+    }
+    RegGlobalsInfo* g = testGlobals(argv[1], argv[2], 100);
+    g->WEIGHTED_PLOT_SEARCH = false;
+    g->FAST_PLOT_SEARCH = true;
+    RegTestManager m(g);
+    m.init();
+    RegRegionInfo* region = m.getRegion();
+
+    int found = 0;
+    for (int period=0;period<3;period++) {
+        m.step();
+        list<RegFarmInfo*>& farms = m.getFarms();
+        for (list<RegFarmInfo*>::iterator f=farms.begin();f!=farms.end();f++) {
+            CHECK((*f)->hasPlotPointer());
+            // plots were released since the renting process
+            (*f)->resetPlotPointer();
+            RegPlotInfo* farmstead = (*f)->getFarmPlot();
+            for (int type=0;type<g->NO_OF_SOIL_TYPES;type++) {
+                RegPlotInfo* p = region->findFreePlotOfType(*f, type);
+                double d = nearest(region, farmstead, type);
+                if (p==NULL) {
+                    CHECK(d<0);
+                    continue;
+                }
+                found++;
+                CHECK(p->getState()==0 && p->getSoilType()==type);
+                CHECK(farmstead->calculateDistance(p)==d);
+                // the cursor stays at the plot while it is free
+                CHECK(region->findFreePlotOfType(*f, type)==p);
+            }
+        }
+    }
+    CHECK(found>0);
+    return TEST_RESULT();
+}
@@ -0,0 +1,76 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// testRegFreePlotSet.cpp
+// order and positions of RegFreePlotSet against a plain list of plot ids
+//---------------------------------------------------------------------------
+#include <random>
+#include <algorithm>
+#include "RegTest.h"
+#include "RegFreePlotSet.h"
+
+// the set holds the plots of ref in this order
+static void compare(const RegFreePlotSet& set, const vector<int>& ref,
+                    const vector<RegPlotInfo*>& plots) {
+    CHECK(set.size()==(int)ref.size());
+    for (unsigned int k=0;k<ref.size();k++)
+        CHECK(set.at(k)==plots[ref[k]]);
+    for (unsigned int id=0;id<plots.size();id++)
+        CHECK(set.contains(plots[id])==(find(ref.begin(),ref.end(),(int)id)!=ref.end()));
+}
+
+int main() {
+    const int rows = 20;
+    const int n = rows*15;
+    RegPlotStore store;
+    vector<RegPlotInfo*> plots;
+    testPlots(store, rows, n, plots);
+
+    RegFreePlotSet set;
+    set.init(n);
+    vector<int> ref;
+    mt19937 rng(4711);
+    for (int step=0;step<20000;step++) {
+        int id = rng()%n;
+        // more adds than removes at first, then the set shrinks again
+        bool add = (int)(rng()%100) < (step<10000 ? 70 : 30);
+        if (add) {
+            set.add(plots[id]);
+            if (find(ref.begin(),ref.end(),id)==ref.end())
+                ref.push_back(id);
+        } else if (!ref.empty()) {
+            // remove a plot at a random position, or one that is not in the set
+            if (rng()%4!=0)
+                id = ref[rng()%ref.size()];
+            set.remove(plots[id]);
+            vector<int>::iterator it = find(ref.begin(),ref.end(),id);
+            if (it!=ref.end())
+                ref.erase(it);
+        }
+        if (step%97==0)
+            compare(set, ref, plots);
+        else if (!ref.empty()) {
+            int k = rng()%ref.size();
+            CHECK(set.at(k)==plots[ref[k]]);
+        }
+    }
+    compare(set, ref, plots);
+
+    // a copied region: the copy of the set holds the handles of the copy
+    RegPlotStore copy = store;
+    vector<RegPlotInfo*> copy_plots;
+    copy.bind(NULL, copy_plots);
+    RegFreePlotSet copy_set = set;
+    copy_set.remap(copy_plots);
+    compare(copy_set, ref, copy_plots);
+    return TEST_RESULT();
+}
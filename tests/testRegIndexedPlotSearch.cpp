@@ -0,0 +1,42 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// testRegIndexedPlotSearch.cpp
+// a simulation with INDEXED_PLOT_SEARCH rents the same plots at the same
+// rents as one that searches the sorted plot lists of the farms
+//---------------------------------------------------------------------------
+#include "RegTest.h"
+#include "RegTestSimulation.h"
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cout << "usage: testRegIndexedPlotSearch <input directory> <output directory>" << endl;
+        return 2;
+    }
+    string out = argv[2];
+    RegGlobalsInfo* g = testGlobals(argv[1], out + "/lists", 100);
+    g->INDEXED_PLOT_SEARCH = false;
+    RegTestManager lists(g);
+    lists.init();
+    g = testGlobals(argv[1], out + "/indexed", 100);
+    g->INDEXED_PLOT_SEARCH = true;
+    RegTestManager indexed(g);
+    indexed.init();
+
+    compareLand(lists, indexed);
+    for (int period=0;period<3;period++) {
+        lists.step();
+        indexed.step();
+        compareLand(lists, indexed);
+    }
+    return TEST_RESULT();
+}
@@ -0,0 +1,76 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// testRegLinkTable.cpp
+// values that RegLinkTable writes to the MIPs of a simulation against
+// triggering every market, invest, reference and number link
+//---------------------------------------------------------------------------
+#include "RegTest.h"
+#include "RegTestSimulation.h"
+#include "RegLpD.h"
+#include "RegLink.h"
+
+static int checked_links = 0;
+
+/** MIP that triggers its links before each solve, after the table
+    was synced, and checks that no destination changes
+*/
+class RegLinkTestLp : public RegLpInfo {
+public:
+    RegLpInfo* create() {
+        return new RegLinkTestLp();
+    }
+    double Lp(RegProductList* PList, vector<int>& ninv, bool prod, int famlabour) {
+        updateLpValues();
+        compare(invest_links);
+        compare(market_links);
+        compare(reference_links);
+        compare(number_links);
+        return RegLpInfo::Lp(PList, ninv, prod, famlabour);
+    }
+private:
+    template<class L> void compare(vector<L*>& links) {
+        double* dest[3] = {mat_val.data(), rhs.data(), obj.data()};
+        for (unsigned int i=0;i<links.size();i++) {
+            double& d = dest[links[i]->getDestKind()][links[i]->getDestNumber()];
+            double synced = d;
+            links[i]->trigger();
+            CHECK(d==synced);
+            checked_links++;
+        }
+    }
+};
+
+/** simulation whose farms solve RegLinkTestLp
+*/
+class RegLinkTestManager : public RegTestManager {
+public:
+    RegLinkTestManager(RegGlobalsInfo* G) : RegTestManager(G) {}
+    RegLpInfo* createMatrix() {
+        return new RegLinkTestLp();
+    }
+};
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cout << "usage: testRegLinkTable <input directory> <output directory>" << endl;
+        return 2;
+    }
+    RegGlobalsInfo* g = testGlobals(argv[1], argv[2], 100);
+    RegLinkTestManager m(g);
+    m.init();
+    // prices, investments and farm values change between the periods
+    for (int period=0;period<3;period++)
+        m.step();
+    CHECK(checked_links>0);
+    return TEST_RESULT();
+}
@@ -0,0 +1,124 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// testRegMipCache.cpp
+// RegMipCache against a list of the entries per shard, most recently used
+// first
+//---------------------------------------------------------------------------
+#include <random>
+#include <sstream>
+#include "RegTest.h"
+#include "RegMipCache.h"
+
+static const int shards = 16;
+static const size_t shard_bytes = 2000;
+
+struct RefEntry {
+    uint64_t hash;
+    string key;
+    double objval;
+};
+
+/// key of the same length for every problem, variant 1 collides with variant 0
+static string key(int id, int variant) {
+    stringstream s;
+    s << "problem " << (100+id) << " variant " << variant;
+    return s.str();
+}
+
+static RegMipCache::Result result(double objval) {
+    RegMipCache::Result r;
+    r.stat = 5;
+    r.objval = objval;
+    r.x.assign(3, objval);
+    return r;
+}
+
+int main() {
+    // entries of one shard until the first one is evicted, all entries
+    // have the same size
+    int capacity = 0;
+    {
+        RegMipCache cache(shards*shard_bytes);
+        do {
+            capacity++;
+            cache.insert(capacity, key(capacity, 0), result(capacity));
+        } while (cache.mayContain(1) && capacity<500);
+        capacity--;
+    }
+    CHECK(capacity>=2);
+
+    RegMipCache cache(shards*shard_bytes);
+    vector<list<RefEntry> > ref(shards);
+    long hits = 0, misses = 0, evictions = 0;
+    mt19937 rng(4711);
+    for (int step=0;step<20000;step++) {
+        // few shards and ids, so that entries are evicted and found again
+        int sh = rng()%3;
+        int id = rng()%(2*capacity);
+        uint64_t hash = ((uint64_t)sh<<60) | id;
+        string k = key(id, rng()%8==0 ? 1 : 0);
+        list<RefEntry>& entries = ref[sh];
+        list<RefEntry>::iterator it = entries.begin();
+        while (it!=entries.end() && it->hash!=hash)
+            it++;
+        CHECK(cache.mayContain(hash)==(it!=entries.end()));
+        if (rng()%2) {
+            RegMipCache::Result r;
+            bool found = cache.find(hash, k, r);
+            bool expected = it!=entries.end() && it->key==k;
+            CHECK(found==expected);
+            if (expected) {
+                hits++;
+                CHECK(r.objval==it->objval && r.x.size()==3 && r.x[2]==it->objval);
+                entries.splice(entries.begin(), entries, it);
+            } else
+                misses++;
+        } else {
+            double objval = step;
+            cache.insert(hash, k, result(objval));
+            // of two problems with the same hash the first one is kept
+            if (it==entries.end()) {
+                if ((int)entries.size()==capacity) {
+                    entries.pop_back();
+                    evictions++;
+                }
+                RefEntry e = {hash, k, objval};
+                entries.push_front(e);
+            }
+        }
+    }
+    CHECK(evictions>0);
+
+    size_t n = 0;
+    for (int sh=0;sh<shards;sh++)
+        n += ref[sh].size();
+    stringstream expected;
+    expected << "MIP cache: " << hits << " hits, " << misses << " misses";
+    if (hits+misses>0)
+        expected << " (" << (100.0*hits)/(hits+misses) << "% hits)";
+    expected << ", " << evictions << " evictions, " << n << " entries, 0 MB" << endl;
+    stringstream statistics;
+    cache.printStatistics(statistics);
+    CHECK(statistics.str()==expected.str());
+
+    // the same image gives the same hash, a changed byte another one
+    RegMipCache::Hasher a, b, c;
+    string image = key(1, 0) + key(2, 0);
+    a.put(image.data(), image.size());
+    b.put(image.data(), image.size());
+    image[5]++;
+    c.put(image.data(), image.size());
+    CHECK(a.value()==b.value());
+    CHECK(a.value()!=c.value());
+    return TEST_RESULT();
+}
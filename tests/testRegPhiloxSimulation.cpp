@@ -0,0 +1,52 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// testRegPhiloxSimulation.cpp
+// two simulations with PHILOX streams for all random numbers, stepped in
+// turn in one process, rent the same plots at the same rents
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include "RegTest.h"
+#include "RegTestSimulation.h"
+
+static RegGlobalsInfo* philoxGlobals(const string& dir, const string& out) {
+    RegGlobalsInfo* g = testGlobals(dir, out, 100);
+    for (unsigned int i=0;i<RegGlobalsInfo::RCOUNT;i++) {
+        string name = g->rand_gen_names[i];
+        transform(name.begin(), name.end(), name.begin(), ::toupper);
+        g->Scenario_globs["RAND_GEN_"+name] = "PHILOX";
+    }
+    return g;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cout << "usage: testRegPhiloxSimulation <input directory> <output directory>" << endl;
+        return 2;
+    }
+    string out = argv[2];
+    RegGlobalsInfo* g = philoxGlobals(argv[1], out + "/first");
+    RegTestManager first(g);
+    first.init();
+    RegTestManager second(philoxGlobals(argv[1], out + "/second"));
+    second.init();
+    for (unsigned int i=0;i<RegGlobalsInfo::RCOUNT;i++)
+        CHECK(g->rand_gens[i].engine==RegGlobalsInfo::PHILOX);
+
+    compareLand(first, second);
+    for (int period=0;period<3;period++) {
+        first.step();
+        second.step();
+        compareLand(first, second);
+    }
+    return TEST_RESULT();
+}
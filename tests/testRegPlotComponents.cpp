@@ -0,0 +1,151 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// testRegPlotComponents.cpp
+// components of RegPlotComponents after merges and releases against a
+// flood fill of the region
+//---------------------------------------------------------------------------
+#include <random>
+#include "RegTest.h"
+#include "RegPlotComponents.h"
+
+static const int rows = 12;
+static const int cols = 9;
+
+static int neighbour(int id, int k) {
+    int row = id%rows;
+    int col = id/rows;
+    switch (k) {
+    case 0:
+        return (row-1+rows)%rows+col*rows;
+    case 1:
+        return row+((col+1)%cols)*rows;
+    case 2:
+        return (row+1)%rows+col*rows;
+    default:
+        return row+((col-1+cols)%cols)*rows;
+    }
+}
+
+/// component number of every plot by flood fill, -1 for plots without farm
+static void label(const vector<RegPlotInfo*>& plots, vector<int>& comp, vector<int>& size) {
+    int n = plots.size();
+    comp.assign(n, -1);
+    size.clear();
+    for (int id=0;id<n;id++) {
+        int farm = RegPlotComponents::owner(plots[id]);
+        if (farm==-1 || comp[id]!=-1)
+            continue;
+        int c = size.size();
+        size.push_back(0);
+        vector<int> stack(1, id);
+        comp[id] = c;
+        while (!stack.empty()) {
+            int p = stack.back();
+            stack.pop_back();
+            size[c]++;
+            for (int k=0;k<4;k++) {
+                int q = neighbour(p, k);
+                if (comp[q]==-1 && RegPlotComponents::owner(plots[q])==farm
+                        && plots[q]->getSoilType()==plots[id]->getSoilType()) {
+                    comp[q] = c;
+                    stack.push_back(q);
+                }
+            }
+        }
+    }
+}
+
+static void compare(RegPlotComponents& comps, const vector<RegPlotInfo*>& plots) {
+    vector<int> comp, size;
+    label(plots, comp, size);
+    int n = plots.size();
+    for (int id=0;id<n;id++) {
+        if (comp[id]==-1)
+            continue;
+        CHECK(comps.size(plots, plots[id])==size[comp[id]]);
+        // the same root for the plots of one component only
+        for (int k=0;k<4;k++) {
+            int q = neighbour(id, k);
+            if (comp[q]!=-1)
+                CHECK((comps.root(plots, plots[id])==comps.root(plots, plots[q]))==(comp[id]==comp[q]));
+        }
+    }
+    for (int id=0;id<n;id++) {
+        for (int farm=0;farm<3;farm++) {
+            int expected = 0;
+            if (comp[id]!=-1 && RegPlotComponents::owner(plots[id])==farm)
+                expected = size[comp[id]]-1;
+            else {
+                vector<int> seen;
+                for (int k=0;k<4;k++) {
+                    int q = neighbour(id, k);
+                    if (comp[q]==-1 || RegPlotComponents::owner(plots[q])!=farm
+                            || plots[q]->getSoilType()!=plots[id]->getSoilType())
+                        continue;
+                    bool counted = false;
+                    for (unsigned int j=0;j<seen.size();j++)
+                        counted = counted || seen[j]==comp[q];
+                    if (!counted) {
+                        seen.push_back(comp[q]);
+                        expected += size[comp[q]];
+                    }
+                }
+            }
+            CHECK(comps.neighbours(plots, plots[id], farm)==expected);
+        }
+    }
+}
+
+int main() {
+    const int n = rows*cols;
+    RegPlotStore store;
+    vector<RegPlotInfo*> plots;
+    testPlots(store, rows, n, plots);
+    mt19937 rng(815);
+    for (int id=0;id<n;id++)
+        plots[id]->setSoilType(rng()%5==0 ? 1 : 0);
+
+    RegPlotComponents comps;
+    comps.init(rows, cols);
+    for (int step=0;step<3000;step++) {
+        RegPlotInfo* p = plots[rng()%n];
+        int farm = rng()%3;
+        // phases without releases, in which the plots are joined
+        // incrementally, and phases after which the components are built again
+        bool releases = (step/300)%2==1;
+        if (p->getState()==0) {
+            // rented or bought by farm
+            if (rng()%2) {
+                store.state[p->getId()] = 1;
+                p->setRentedByAgent(farm);
+            } else {
+                store.state[p->getId()] = 3;
+                p->setOccupiedByAgent(farm);
+            }
+            comps.occupied(plots, p);
+        } else if (releases && rng()%2) {
+            store.state[p->getId()] = 0;
+            p->setRentedByAgent(-1);
+            p->setOccupiedByAgent(-1);
+            comps.released();
+        } else if (p->getState()==1 && rng()%10==0) {
+            // a plot changing its farm without being released
+            p->setRentedByAgent(farm);
+            comps.occupied(plots, p);
+        }
+        if (step%25==0)
+            compare(comps, plots);
+    }
+    compare(comps, plots);
+    return TEST_RESULT();
+}
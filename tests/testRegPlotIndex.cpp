@@ -0,0 +1,105 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// testRegPlotIndex.cpp
+// RegPlotIndex::findCheapest() against a scan of all plots
+//---------------------------------------------------------------------------
+#include <random>
+#include <math.h>
+#include "RegTest.h"
+#include "RegPlotIndex.h"
+
+// more than 64 rows and columns, so the bitmaps have several words
+static const int rows = 70;
+static const int cols = 131;
+static const int types = 3;
+static const double unit = 2.0;
+
+/// distance of the plots on the torus in plot lengths
+static double distance(RegPlotInfo* p, int row, int col) {
+    int dr = abs(p->getRow()-row);
+    int dc = abs(p->getCol()-col);
+    dr = min(dr, rows-dr);
+    dc = min(dc, cols-dc);
+    return sqrt((double)(dr*dr+dc*dc));
+}
+
+static RegPlotInfo* scan(const vector<RegPlotInfo*>& plots, int type,
+                         const function<double(RegPlotInfo*)>& cost) {
+    RegPlotInfo* best = NULL;
+    double best_cost = 0;
+    for (unsigned int id=0;id<plots.size();id++) {
+        RegPlotInfo* p = plots[id];
+        if (p->getState()!=0 || p->getSoilType()!=type)
+            continue;
+        double c = cost(p);
+        if (best==NULL || c<best_cost) {
+            best = p;
+            best_cost = c;
+        }
+    }
+    return best;
+}
+
+int main() {
+    const int n = rows*cols;
+    RegPlotStore store;
+    vector<RegPlotInfo*> plots;
+    testPlots(store, rows, n, plots);
+    mt19937 rng(1234);
+    // costs on top of the distance costs, in steps of 0.5 so that some are equal
+    vector<double> extra(n);
+    for (int id=0;id<n;id++) {
+        plots[id]->setSoilType(rng()%types);
+        extra[id] = 0.5*(rng()%8);
+        store.state[id] = rng()%10<7 ? 1 : 0;
+    }
+    RegPlotIndex index;
+    index.init(plots, rows, cols, types);
+
+    for (int step=0;step<4000;step++) {
+        // a plot changes hands
+        RegPlotInfo* p = plots[rng()%n];
+        if (p->getState()==0) {
+            store.state[p->getId()] = 1;
+            index.setOccupied(p);
+        } else {
+            store.state[p->getId()] = 0;
+            index.setFree(p);
+        }
+        // search of a farmstead
+        int row = rng()%rows;
+        int col = rng()%cols;
+        int type = rng()%types;
+        function<double(RegPlotInfo*)> cost = [&](RegPlotInfo* q) {
+            return unit*distance(q, row, col)+extra[q->getId()];
+        };
+        CHECK(index.findCheapest(plots, type, row, col, unit, cost)==scan(plots, type, cost));
+    }
+
+    // few free plots: the search goes round the whole torus
+    for (int id=0;id<n;id++)
+        if (plots[id]->getState()==0 && rng()%50!=0) {
+            store.state[id] = 1;
+            index.setOccupied(plots[id]);
+        }
+    for (int step=0;step<200;step++) {
+        int row = rng()%rows;
+        int col = rng()%cols;
+        int type = rng()%types;
+        function<double(RegPlotInfo*)> cost = [&](RegPlotInfo* q) {
+            return unit*distance(q, row, col)+extra[q->getId()];
+        };
+        CHECK(index.findCheapest(plots, type, row, col, unit, cost)==scan(plots, type, cost));
+    }
+    return TEST_RESULT();
+}
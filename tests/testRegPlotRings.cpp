@@ -0,0 +1,55 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// testRegPlotRings.cpp
+// order of RegPlotRings::plotAt() against the plots sorted by distance
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include <tuple>
+#include "RegTest.h"
+#include "RegPlotRings.h"
+
+/// offset d of x on a torus of size n, in -(n-1)/2..n/2
+static int offset(int x, int from, int n) {
+    int d = ((x-from)%n+n)%n;
+    return d>n/2 ? d-n : d;
+}
+
+static void compare(int rows, int cols) {
+    RegPlotRings rings;
+    rings.init(rows, cols);
+    CHECK(rings.size()==(unsigned int)(rows*cols));
+    for (int row=0;row<rows;row++)
+        for (int col=0;col<cols;col++) {
+            // squared distance, column offset, row offset, id
+            vector<tuple<int,int,int,int> > ref;
+            for (int c=0;c<cols;c++)
+                for (int r=0;r<rows;r++) {
+                    int dr = offset(r, row, rows);
+                    int dc = offset(c, col, cols);
+                    ref.push_back(make_tuple(dr*dr+dc*dc, dc, dr, c*rows+r));
+                }
+            sort(ref.begin(), ref.end());
+            for (unsigned int k=0;k<ref.size();k++)
+                CHECK(rings.plotAt(k, row, col)==get<3>(ref[k]));
+        }
+}
+
+int main() {
+    compare(1, 1);
+    compare(1, 9);
+    compare(7, 5);
+    compare(6, 8);
+    compare(10, 10);
+    compare(13, 4);
+    return TEST_RESULT();
+}
@@ -0,0 +1,66 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// testRegRandom.cpp
+// RegPhilox against the known answers of Random123 philox4x32-10 and of
+// FNV-1a, and the numbering of the draws of RegRandomStreams
+//---------------------------------------------------------------------------
+#include "RegTest.h"
+#include "RegRandom.h"
+
+static void known(uint32_t c0, uint32_t c1, uint32_t c2, uint32_t c3,
+                  uint32_t k0, uint32_t k1,
+                  uint32_t o0, uint32_t o1, uint32_t o2, uint32_t o3) {
+    const uint32_t key[2] = {k0, k1};
+    const uint32_t ctr[4] = {c0, c1, c2, c3};
+    uint32_t out[4];
+    RegPhilox::block(key, ctr, out);
+    CHECK(out[0]==o0 && out[1]==o1 && out[2]==o2 && out[3]==o3);
+}
+
+int main() {
+    // kat_vectors of Random123
+    known(0, 0, 0, 0, 0, 0,
+          0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u);
+    known(0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu,
+          0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu);
+    known(0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u, 0xa4093822u, 0x299f31d0u,
+          0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u);
+
+    // the engine returns the words of the blocks (farm,iteration,draw,0), (...,1), ...
+    RegPhilox engine(7, 11, 3, 5, 2);
+    const uint32_t key[2] = {7, 11};
+    for (uint32_t b=0;b<3;b++) {
+        const uint32_t ctr[4] = {3, 5, 2, b};
+        uint32_t out[4];
+        RegPhilox::block(key, ctr, out);
+        for (int i=0;i<4;i++)
+            CHECK(engine()==out[i]);
+    }
+
+    // FNV-1a, 32 bit
+    CHECK(RegPhilox::streamKey("")==0x811c9dc5u);
+    CHECK(RegPhilox::streamKey("a")==0xe40c292cu);
+    CHECK(RegPhilox::streamKey("foobar")==0xbf9cf968u);
+
+    // draws are counted per stream from 0 in every iteration
+    RegRandomStreams streams(4);
+    CHECK(streams.getFarm()==4);
+    CHECK(streams.next(2, 0)==0);
+    CHECK(streams.next(2, 0)==1);
+    CHECK(streams.next(0, 0)==0);
+    CHECK(streams.next(2, 0)==2);
+    CHECK(streams.next(2, 1)==0);
+    CHECK(streams.next(0, 1)==0);
+    CHECK(streams.next(2, 1)==1);
+    return TEST_RESULT();
+}
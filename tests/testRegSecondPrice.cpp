@@ -0,0 +1,110 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// testRegSecondPrice.cpp
+// second prices of the old renting process, with the farms whose offers are
+// bounded asked only while they may exceed the others, against the highest
+// offer of all other farms
+//---------------------------------------------------------------------------
+#include <cmath>
+#include "RegTest.h"
+#include "RegTestSimulation.h"
+
+/** simulation that allocates the land of a period as LandAllocation() does
+    and checks the second price of every plot before it is rented
+*/
+class RegSecondPriceManager : public RegTestManager {
+public:
+    RegSecondPriceManager(RegGlobalsInfo* G) : RegTestManager(G) {}
+    /// @return number of second prices checked
+    int allocateLand() {
+        PreparationForPeriod();
+        vector<int> count_rented_plots_of_type(g->NO_OF_SOIL_TYPES, 0);
+        int checked = 0;
+        bool stop;
+        bidcount = 0;
+        bid_queue.init(vector<RegFarmInfo*>(FarmList.begin(), FarmList.end()), g->NO_OF_SOIL_TYPES);
+        do {
+            stop = true;
+            for (int i=0;i<g->NO_OF_SOIL_TYPES;i++) {
+                if (Region->getFreeLandPlotsOfType(i)>0) {
+                    if (checkSecondOffer(i))
+                        checked++;
+                    if (rentOnePlot(count_rented_plots_of_type, i)>0)
+                        stop = false;
+                }
+            }
+            bidcount++;
+        } while (!stop);
+        return checked;
+    }
+private:
+    /** the highest bidder for type and its wanted plot as found by asking
+        every farm, and secondOffer() for that plot against the highest
+        offer of all other farms
+        @return false if no farm offers anything
+    */
+    bool checkSecondOffer(int type) {
+        const vector<RegFarmInfo*>& farms = bid_queue.getFarms();
+        RegFarmInfo* winner = NULL;
+        double maxoffer = 0;
+        for (unsigned int i=0;i<farms.size();i++) {
+            farms[i]->demandForLandOfType(type, bidcount);
+            double offer = farms[i]->getRentOffer();
+            if (offer>maxoffer) {
+                maxoffer = offer;
+                winner = farms[i];
+            }
+        }
+        if (winner==NULL)
+            return false;
+        RegPlotInfo* pl = winner->getWantedPlotOfType(type);
+        vector<char> recomputed(farms.size(), 0);
+        double second_offer = secondOffer(pl, winner, recomputed);
+        for (unsigned int i=0;i<farms.size();i++)
+            if (recomputed[i])
+                bid_queue.invalidateOffer(i, type);
+
+        double reference = 0;
+        for (unsigned int i=0;i<farms.size();i++) {
+            if (farms[i]==winner)
+                continue;
+            bool recomputed_offer = false;
+            double offer = farms[i]->getRentOffer(pl, &recomputed_offer);
+            if (recomputed_offer)
+                bid_queue.invalidateOffer(i, type);
+            if (offer>reference)
+                reference = offer;
+        }
+        CHECK(fabs(second_offer-reference)<=1e-9*(1+fabs(reference)));
+        return true;
+    }
+};
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cout << "usage: testRegSecondPrice <input directory> <output directory>" << endl;
+        return 2;
+    }
+    RegGlobalsInfo* g = testGlobals(argv[1], argv[2], 100);
+    // the scenario rents by the other process and at second prices
+    g->OLD_LAND_RENTING_PROCESS = true;
+    g->FIRSTPRICE = false;
+    RegSecondPriceManager* m = new RegSecondPriceManager(g);
+    m->init();
+    // no land is rented in the first period
+    m->step();
+    m->step();
+    CHECK(m->allocateLand()>0);
+    delete m;
+    return TEST_RESULT();
+}
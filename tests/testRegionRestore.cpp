@@ -0,0 +1,72 @@
+/*************************************************************************
+* This file is part of AgriPoliS
+*
+* AgriPoliS: An Agricultural Policy Simulator
+*
+* Copyright (c) 2024, Alfons Balmann, Kathrin Happe, Konrad Kellermann et al.
+* (cf. AUTHORS.md) at Leibniz Institute of Agricultural Development in
+* Transition Economies
+*
+* SPDX-License-Identifier: MIT
+**************************************************************************/
+
+// testRegionRestore.cpp
+// RegRegionInfo::restore() copies back the data of the plots and leaves the
+// handles the farms point to in place
+//---------------------------------------------------------------------------
+#include "RegTest.h"
+#include "RegTestSimulation.h"
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cout << "usage: testRegionRestore <input directory> <output directory>" << endl;
+        return 2;
+    }
+    RegGlobalsInfo* g = testGlobals(argv[1], argv[2], 100);
+    RegTestManager m(g);
+    m.init();
+    RegRegionInfo* region = m.getRegion();
+
+    RegFarmInfo* farm = m.getFarms().front();
+    RegPlotInfo* farmstead = farm->getFarmPlot();
+    int id = farmstead->getId();
+    double rent = farmstead->getRentPaid();
+    int soil = farmstead->getSoilType();
+    RegPlotInfo* rented = NULL;
+    for (unsigned int i=0;i<region->plots.size() && !rented;i++)
+        if (region->plots[i]->getState()==1)
+            rented = region->plots[i];
+    CHECK(rented!=NULL);
+    int rented_by = rented->getRentedByAgent();
+    int free_plots = region->free_plots.size();
+
+    region->backup();
+    farmstead->setRentPaid(rent+1000);
+    farmstead->setSoilType(soil+1);
+    region->releasePlot(rented);
+    CHECK(region->free_plots.size()==free_plots+1);
+    region->restore();
+
+    // the farm's handle is the region's and shows the data of the backup
+    CHECK(region->plots[id]==farmstead);
+    CHECK(farm->getFarmPlot()->getRentPaid()==rent);
+    CHECK(region->plots[id]->getRentPaid()==rent);
+    CHECK(region->plots[id]->getSoilType()==soil);
+    CHECK(region->plots[rented->getId()]==rented);
+    CHECK(rented->getState()==1);
+    CHECK(rented->getRentedByAgent()==rented_by);
+
+    // the free plots are handles of the region
+    CHECK(region->free_plots.size()==free_plots);
+    CHECK(!region->free_plots.contains(rented));
+    for (int k=0;k<region->free_plots.size();k++) {
+        RegPlotInfo* p = region->free_plots.at(k);
+        CHECK(region->plots[p->getId()]==p);
+        CHECK(p->getState()==0);
+    }
+
+    // a change after the restore is seen through both handles
+    region->plots[id]->setRentPaid(rent+1);
+    CHECK(farmstead->getRentPaid()==rent+1);
+    return TEST_RESULT();
+}